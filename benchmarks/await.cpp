@@ -0,0 +1,73 @@
+#include <cstdint>
+
+#include <u/diagnostics/awaiting.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+struct field_error
+{
+	std::uint32_t field;
+};
+
+constexpr std::uint32_t failure_period{1024};
+
+[[gnu::always_inline]]
+inline u::result<std::uint32_t, field_error> check(
+	std::uint32_t input,
+	std::uint32_t field)
+{
+	if ((input + field) % failure_period == 0) [[unlikely]]
+		return u::error{field_error{field}};
+	return input ^ field;
+}
+
+// Both variants validate the same eight fields in sequence; only the way
+// failures leave the chain differs.
+
+[[gnu::noinline]]
+u::result<std::uint32_t, field_error> manual(std::uint32_t input)
+{
+	std::uint32_t sum{};
+	for (std::uint32_t field{}; field != 8; ++field) {
+		auto result = check(input, field);
+		if (!result.has_value())
+			return u::error{result.error()};
+		sum += *result;
+	}
+	return sum;
+}
+
+u::result<std::uint32_t, field_error> awaiting(std::uint32_t input)
+{
+	std::uint32_t sum{};
+	for (std::uint32_t field{}; field != 8; ++field)
+		sum += co_await check(input, field);
+	co_return sum;
+}
+
+// The coroutine is inlined into a non-coroutine caller, which is what lets
+// the allocation of its frame be elided.
+[[gnu::noinline]]
+u::result<std::uint32_t, field_error> awaiting_caller(std::uint32_t input)
+{ return awaiting(input); }
+
+}
+
+auto main() -> int
+{
+	constexpr std::size_t iterations{50'000'000};
+
+	benchmarking::measure("manual checks", iterations, [](std::size_t i) {
+		auto result = manual(static_cast<std::uint32_t>(i));
+		benchmarking::do_not_optimize(result);
+	});
+
+	benchmarking::measure("co_await", iterations, [](std::size_t i) {
+		auto result = awaiting_caller(static_cast<std::uint32_t>(i));
+		benchmarking::do_not_optimize(result);
+	});
+	return 0;
+}
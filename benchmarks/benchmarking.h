@@ -0,0 +1,39 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace benchmarking
+{
+
+template<typename T>
+inline void do_not_optimize(T&& value) noexcept
+{ asm volatile("" : : "r,m"(value) : "memory"); }
+
+inline void clobber() noexcept
+{ asm volatile("" : : : "memory"); }
+
+// Runs `fn` `iterations` times and prints the mean time per iteration.
+template<typename F>
+double measure(const char* name, std::size_t iterations, F&& fn)
+{
+	for (std::size_t i{0}; i < iterations / 16; ++i)
+		fn(i);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i{0}; i < iterations; ++i)
+		fn(i);
+	const auto stop = std::chrono::steady_clock::now();
+
+	const double nanoseconds =
+		std::chrono::duration<double, std::nano>(stop - start).count()
+		/ static_cast<double>(iterations);
+	std::printf("%-48s %10.3f ns\n", name, nanoseconds);
+	return nanoseconds;
+}
+
+}
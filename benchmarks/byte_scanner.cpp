@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <u/byte_scanner.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+constexpr std::size_t size{1 << 24};
+constexpr std::string_view delimiters{",\n\"\\;:|\t{}[]<>=&"};
+
+// Words with a byte of one of the delimiters about every 32 bytes.
+std::string make_text()
+{
+	std::mt19937_64 random{42};
+	std::string text(size, ' ');
+	for (char& c : text)
+		c = random() % 32 == 0
+			? delimiters[random() % delimiters.size()]
+			: static_cast<char>('a' + random() % 26);
+	return text;
+}
+
+void report(const std::string& name, double nanoseconds)
+{ std::printf("%-48s %10.3f GB/s\n", name.c_str(), static_cast<double>(size) / nanoseconds); }
+
+}
+
+auto main() -> int
+{
+	const std::string text = make_text();
+
+	for (std::size_t count{1}; count <= delimiters.size(); ++count) {
+		const std::string_view bytes = delimiters.substr(0, count);
+		const u::byte_set set{bytes};
+		const std::string label = ", " + std::to_string(count) + " bytes";
+
+		report("u::byte_scanner" + label, benchmarking::measure(("u::byte_scanner" + label).c_str(), 50, [&](std::size_t) {
+			std::size_t sum{0};
+			for (const std::size_t offset : u::byte_scanner{text, set})
+				sum += offset;
+			benchmarking::do_not_optimize(sum);
+		}));
+		report("u::find_first_of" + label, benchmarking::measure(("u::find_first_of" + label).c_str(), 50, [&](std::size_t) {
+			std::size_t sum{0};
+			for (std::size_t offset = u::find_first_of(text, set);
+					offset != text.size();
+					offset = u::find_first_of(text, set, offset + 1))
+				sum += offset;
+			benchmarking::do_not_optimize(sum);
+		}));
+		report("std::string_view::find_first_of" + label, benchmarking::measure(("std::string_view::find_first_of" + label).c_str(), 5, [&](std::size_t) {
+			const std::string_view view{text};
+			std::size_t sum{0};
+			for (std::size_t offset = view.find_first_of(bytes);
+					offset != std::string_view::npos;
+					offset = view.find_first_of(bytes, offset + 1))
+				sum += offset;
+			benchmarking::do_not_optimize(sum);
+		}));
+		if (count == 1)
+			report("memchr" + label, benchmarking::measure(("memchr" + label).c_str(), 50, [&](std::size_t) {
+				const char* const last = text.data() + text.size();
+				std::size_t sum{0};
+				for (const char* at = text.data();
+						(at = static_cast<const char*>(std::memchr(at, bytes.front(), static_cast<std::size_t>(last - at)))) != nullptr;
+						++at)
+					sum += static_cast<std::size_t>(at - text.data());
+				benchmarking::do_not_optimize(sum);
+			}));
+	}
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+#include <u/diagnostics/chaining.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+std::size_t moves{0};
+
+struct frame
+{
+	std::array<std::uint64_t, 32> words;
+
+	explicit frame(std::uint64_t seed) noexcept
+	{ this->words.fill(seed); }
+
+	frame(const frame&) = delete;
+
+	frame(frame&& other) noexcept
+		: words{other.words}
+	{ ++moves; }
+};
+
+enum class code : std::uint32_t
+{
+	none,
+	bad_magic,
+	bad_length,
+	bad_checksum
+};
+
+struct failure
+{
+	code reason;
+	std::uint32_t stage;
+};
+
+constexpr std::uint64_t failure_period{1024};
+
+[[gnu::noinline]]
+u::result<frame, code> receive(std::uint64_t seed)
+{
+	if (seed % failure_period == 0) [[unlikely]]
+		return u::error{code::bad_magic};
+	return u::result<frame, code>{std::in_place, seed};
+}
+
+u::result<void, code> check_length(const frame& input)
+{
+	if (input.words[0] % (failure_period + 1) == 0) [[unlikely]]
+		return u::error{code::bad_length};
+	return {};
+}
+
+u::result<void, code> check_checksum(const frame& input)
+{
+	if (input.words[31] % (failure_period + 3) == 0) [[unlikely]]
+		return u::error{code::bad_checksum};
+	return {};
+}
+
+// The eager version passes the frame through every stage by value, the way
+// `and_then` and `or_else` chains are written today.
+
+[[gnu::noinline]]
+u::result<frame, failure> eager(std::uint64_t seed)
+{
+	const auto keep_if = [](auto check) {
+		return [check](frame&& input) -> u::result<frame, code> {
+			if (auto status = check(input); !status.has_value())
+				return u::error{status.error()};
+			return std::move(input);
+		};
+	};
+	return receive(seed)
+		.and_then(keep_if(check_length))
+		.and_then(keep_if(check_checksum))
+		.and_then(keep_if(check_length))
+		.and_then(keep_if(check_checksum))
+		.or_else([](code&& error) -> u::result<frame, failure> {
+			return u::error{failure{error, 0}};
+		});
+}
+
+[[gnu::noinline]]
+u::result<frame, failure> chained(std::uint64_t seed)
+{
+	return receive(seed)
+		| u::check(check_length)
+		| u::check(check_checksum)
+		| u::check(check_length)
+		| u::check(check_checksum)
+		| u::map_error([](code error) { return failure{error, 0}; });
+}
+
+template<typename F>
+void report_moves(const char* name, F&& fn)
+{
+	moves = 0;
+	auto result = fn(7);
+	benchmarking::do_not_optimize(result);
+	std::printf("%-48s %10zu moves\n", name, moves);
+}
+
+}
+
+auto main() -> int
+{
+	constexpr std::size_t iterations{20'000'000};
+
+	report_moves("eager and_then", eager);
+	report_moves("u::check pipeline", chained);
+
+	benchmarking::measure("eager and_then", iterations, [](std::size_t i) {
+		auto result = eager(i);
+		benchmarking::do_not_optimize(result);
+	});
+
+	benchmarking::measure("u::check pipeline", iterations, [](std::size_t i) {
+		auto result = chained(i);
+		benchmarking::do_not_optimize(result);
+	});
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <u/diagnostics/error_arena.h>
+#include <u/diagnostics/result.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// Fails every other call with a message naming the offset, as a parser
+// does on malformed input.
+template<typename ErrorType>
+[[gnu::noinline]]
+u::result<int, ErrorType> check(std::size_t i)
+{
+	if (i % 2 == 0)
+		return static_cast<int>(i);
+
+	char offset[20];
+	const auto end = std::to_chars(offset, offset + sizeof(offset), i).ptr;
+	const std::string_view digits{offset, static_cast<std::size_t>(end - offset)};
+	if constexpr (std::is_same_v<ErrorType, u::error_ref>)
+		return u::error<u::error_ref>{u::error_ref::make(
+			"unexpected character at offset ",
+			digits,
+			" of the request body")};
+	else {
+		std::string message{"unexpected character at offset "};
+		message += digits;
+		message += " of the request body";
+		return u::error<std::string>{std::move(message)};
+	}
+}
+
+// Handles a request of 64 checks, and resets the arena at its end.
+template<typename ErrorType>
+void run(const char* name)
+{
+	benchmarking::measure(name, 200'000, [](std::size_t request) {
+		std::size_t failures{0};
+		for (std::size_t i{request * 64}; i < request * 64 + 64; ++i) {
+			auto checked = check<ErrorType>(i);
+			if (!checked.has_value()) {
+				if constexpr (std::is_same_v<ErrorType, u::error_ref>)
+					failures += checked.error().message().size();
+				else failures += checked.error().size();
+			}
+			benchmarking::do_not_optimize(checked);
+		}
+		benchmarking::do_not_optimize(failures);
+		if constexpr (std::is_same_v<ErrorType, u::error_ref>)
+			u::error_arena::current().reset();
+	});
+}
+
+}
+
+auto main() -> int
+{
+	run<std::string>("result<int, std::string>, 64 checks, half fail");
+	run<u::error_ref>("result<int, error_ref>, 64 checks, half fail");
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <u/diagnostics/error_chain.h>
+#include <u/diagnostics/result.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// Three layers which each add context to the error of the one below, as a
+// service does from the tokenizer up to the request handler. The message
+// is either built at every layer, or only kept as frames.
+[[gnu::noinline]]
+u::result<int, std::string> eager_token(std::size_t offset)
+{
+	char digits[20];
+	const auto end = std::to_chars(digits, digits + sizeof(digits), offset).ptr;
+	return u::error<std::string>{
+		"at offset " + std::string(digits, end) + ": invalid character"};
+}
+
+[[gnu::noinline]]
+u::result<int, std::string> eager_field(std::size_t offset, std::string_view key)
+{
+	return eager_token(offset)
+		| u::map_error([&](std::string error) {
+			return "in \"" + std::string{key} + "\" " + error;
+		});
+}
+
+[[gnu::noinline]]
+u::result<int, std::string> eager_header(std::size_t offset)
+{
+	return eager_field(offset, "content-length")
+		| u::map_error([](std::string error) {
+			return "while reading the header: " + error;
+		});
+}
+
+[[gnu::noinline]]
+u::result<int, u::error_chain> lazy_token(std::size_t offset)
+{
+	return u::error<u::error_chain>{u::error_chain::make({
+		.what = "invalid character",
+		.offset = offset})};
+}
+
+[[gnu::noinline]]
+u::result<int, u::error_chain> lazy_field(std::size_t offset, std::string_view key)
+{ return lazy_token(offset) | u::with_context({.key = key}); }
+
+[[gnu::noinline]]
+u::result<int, u::error_chain> lazy_header(std::size_t offset)
+{
+	return lazy_field(offset, "content-length")
+		| u::with_context({.what = "while reading the header"});
+}
+
+}
+
+auto main() -> int
+{
+	// Every error is counted, and one in a hundred is printed.
+	benchmarking::measure("eager std::string, 3 layers", 1'000'000, [](std::size_t i) {
+		const auto header = eager_header(i);
+		benchmarking::do_not_optimize(header.error().size());
+		if (i % 100 == 0)
+			benchmarking::do_not_optimize(header.error());
+	});
+	benchmarking::measure("lazy error_chain, 3 layers", 1'000'000, [](std::size_t i) {
+		const auto header = lazy_header(i);
+		benchmarking::do_not_optimize(header.error().root_cause().what.data());
+		if (i % 100 == 0)
+			benchmarking::do_not_optimize(header.error().to_string());
+		if (i % 64 == 63)
+			u::error_arena::current().reset();
+	});
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include <array>
+#include <string_view>
+
+#include <u/grammar.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+namespace g = u::grammar;
+
+struct request_line
+{
+	std::string_view method;
+	std::string_view target;
+	int major;
+	int minor;
+};
+
+constexpr auto digit = g::character_set::range('0', '9');
+constexpr auto token_character =
+	g::character_set::range('a', 'z')
+	| g::character_set::range('A', 'Z')
+	| digit
+	| g::character_set{"!#$%&'*+-.^_`|~"};
+
+constexpr auto parse_combined = g::map(
+	g::sequence(
+		g::many(g::character(token_character), 1),
+		g::literal(" "),
+		g::many(g::character(g::character_set::range('!', '~')), 1),
+		g::literal(" HTTP/"),
+		g::character(digit),
+		g::literal("."),
+		g::character(digit),
+		g::literal("\r\n")),
+	[](auto method, auto, auto target, auto, char major, auto, char minor, auto) {
+		return request_line{method, target, major - '0', minor - '0'};
+	});
+
+constexpr bool is_token_character(char c) noexcept
+{
+	return (c >= 'a' && c <= 'z')
+		|| (c >= 'A' && c <= 'Z')
+		|| (c >= '0' && c <= '9')
+		|| std::string_view{"!#$%&'*+-.^_`|~"}.find(c) != std::string_view::npos;
+}
+
+// The request line parser as it would be written by hand.
+u::grammar::parse_result<request_line> parse_by_hand(std::string_view input)
+{
+	const auto mismatch = u::error<u::parse_error>{u::parse_error::invalid_argument};
+
+	std::size_t at{0};
+	while (at < input.size() && is_token_character(input[at]))
+		++at;
+	if (at == 0 || at == input.size() || input[at] != ' ')
+		return mismatch;
+	const std::string_view method = input.substr(0, at);
+
+	const std::size_t target_start = ++at;
+	while (at < input.size() && input[at] >= '!' && input[at] <= '~')
+		++at;
+	if (at == target_start)
+		return mismatch;
+	const std::string_view target = input.substr(target_start, at - target_start);
+
+	const std::string_view version = input.substr(at);
+	if (version.size() < 11
+			|| !version.starts_with(" HTTP/")
+			|| version[6] < '0' || version[6] > '9'
+			|| version[7] != '.'
+			|| version[8] < '0' || version[8] > '9'
+			|| version.substr(9, 2) != "\r\n")
+		return mismatch;
+
+	return u::parsed<request_line>{
+		request_line{method, target, version[6] - '0', version[8] - '0'},
+		at + 11};
+}
+
+constexpr std::array<std::string_view, 4> lines{
+	"GET /index.html HTTP/1.1\r\n",
+	"POST /api/v2/orders?customer=1234&expand=items HTTP/1.1\r\n",
+	"OPTIONS * HTTP/1.0\r\n",
+	"DELETE /sessions/7f3e2a10c8d94b6e HTTP/1.1\r\n"};
+
+}
+
+auto main() -> int
+{
+	benchmarking::measure("u::grammar", 20'000'000, [](std::size_t i) {
+		auto parsed = parse_combined(lines[i % lines.size()]);
+		benchmarking::do_not_optimize(parsed);
+	});
+	benchmarking::measure("by hand", 20'000'000, [](std::size_t i) {
+		auto parsed = parse_by_hand(lines[i % lines.size()]);
+		benchmarking::do_not_optimize(parsed);
+	});
+	return 0;
+}
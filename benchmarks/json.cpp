@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <u/json.h>
+#include <u/utf8.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// Records as an API returns them, with more fields than a reader needs.
+std::string make_text()
+{
+	std::mt19937_64 random{42};
+	std::string text{"["};
+	for (std::size_t i{0}; i < 20'000; ++i) {
+		if (i != 0)
+			text += ",\n";
+		text += "{\"id\": " + std::to_string(random() % 1'000'000)
+			+ ", \"name\": \"item \\\"" + std::to_string(i) + "\\\" \xc3\xa9t\xc3\xa9\""
+			+ ", \"price\": " + std::to_string(random() % 100'000) + "." + std::to_string(random() % 100)
+			+ ", \"tags\": [\"a\", \"bb\", \"ccc\"], \"active\": " + (random() % 2 ? "true" : "false")
+			+ ", \"owner\": {\"name\": \"someone\", \"groups\": [1, 2, 3, 4]}}";
+	}
+	return text + "]";
+}
+
+void report(const char* name, std::size_t size, double nanoseconds)
+{ std::printf("%-48s %10.3f GB/s\n", name, static_cast<double>(size) / nanoseconds); }
+
+}
+
+auto main() -> int
+{
+	const std::string text = make_text();
+
+	report("u::validate_utf8", text.size(), benchmarking::measure("u::validate_utf8", 200, [&](std::size_t) {
+		benchmarking::do_not_optimize(u::validate_utf8(text));
+	}));
+	report("u::json::document::parse", text.size(), benchmarking::measure("u::json::document::parse", 200, [&](std::size_t) {
+		benchmarking::do_not_optimize(u::json::document::parse(text));
+	}));
+	report("parse, then sum every price", text.size(), benchmarking::measure("parse, then sum every price", 200, [&](std::size_t) {
+		const auto document = u::json::document::parse(text);
+		const auto records = document->root().elements();
+		double sum{0};
+		for (const u::json::value record : *records)
+			sum += record["price"]
+				.and_then([](u::json::value price) { return price.get<double>(); })
+				.value_or(0);
+		benchmarking::do_not_optimize(sum);
+	}));
+	return 0;
+}
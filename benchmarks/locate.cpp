@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <u/parsing.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+constexpr std::size_t size{1 << 24};
+
+// Lines of a few numbers, as in a delimited file.
+std::string make_text()
+{
+	std::mt19937_64 random{42};
+	std::string text;
+	while (text.size() < size)
+		text += std::to_string(random() % 100'000) + ',' + std::to_string(random() % 1'000) + '\n';
+	return text;
+}
+
+// Counts lines one byte at a time, as a parser which tracks them does.
+u::text_location locate_by_byte(std::string_view text, std::size_t offset)
+{
+	u::text_location location{1, 1};
+	for (std::size_t i{0}; i < offset; ++i) {
+		if (text[i] == '\n')
+			location = u::text_location{location.line + 1, 1};
+		else ++location.column;
+	}
+	return location;
+}
+
+void report(const char* name, std::size_t bytes, double nanoseconds)
+{ std::printf("%-48s %10.3f GB/s\n", name, static_cast<double>(bytes) / nanoseconds); }
+
+}
+
+auto main() -> int
+{
+	const std::string text = make_text();
+	const std::size_t offset = text.size() - 1;
+
+	report("u::locate, at the end", offset, benchmarking::measure("u::locate, at the end", 100, [&](std::size_t) {
+		benchmarking::do_not_optimize(u::locate(text, offset));
+	}));
+	report("by byte, at the end", offset, benchmarking::measure("by byte, at the end", 20, [&](std::size_t) {
+		benchmarking::do_not_optimize(locate_by_byte(text, offset));
+	}));
+	return 0;
+}
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <u/mapped_file.h>
+#include <u/tokenizer.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+constexpr const char* path{"benchmark-mapped_file.txt"};
+
+void write_file(std::size_t count)
+{
+	std::mt19937_64 random{42};
+	std::string text;
+	for (std::size_t i{0}; i < count; ++i)
+		text += std::to_string(static_cast<std::int64_t>(random() >> 8)) + '\n';
+
+	std::FILE* file = std::fopen(path, "wb");
+	std::fwrite(text.data(), 1, text.size(), file);
+	std::fclose(file);
+}
+
+std::int64_t sum(std::string_view text)
+{
+	u::tokenizer tokens{text, "\n"};
+	std::int64_t sum{0};
+	while (!tokens.at_end())
+		sum += tokens.parse<std::int64_t>().value();
+	return sum;
+}
+
+// Reads the file into a buffer on the heap and parses the buffer.
+std::int64_t read_and_parse()
+{
+	const int descriptor = ::open(path, O_RDONLY);
+	std::string buffer(static_cast<std::size_t>(::lseek(descriptor, 0, SEEK_END)), '\0');
+	::pread(descriptor, buffer.data(), buffer.size(), 0);
+	::close(descriptor);
+	return sum(buffer);
+}
+
+// Maps the file and parses the mapping in place.
+std::int64_t map_and_parse()
+{
+	const auto file = u::mapped_file::open(path);
+	return sum(file->view());
+}
+
+}
+
+auto main() -> int
+{
+	for (const std::size_t count : {10'000, 1'000'000, 10'000'000}) {
+		write_file(count);
+		const std::size_t iterations{100'000'000 / count};
+		const auto label = std::to_string(count) + " lines";
+
+		benchmarking::measure(
+			("read, " + label).c_str(),
+			iterations,
+			[&](std::size_t) { benchmarking::do_not_optimize(read_and_parse()); });
+		benchmarking::measure(
+			("mapped_file, " + label).c_str(),
+			iterations,
+			[&](std::size_t) { benchmarking::do_not_optimize(map_and_parse()); });
+	}
+	std::remove(path);
+	return 0;
+}
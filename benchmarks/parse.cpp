@@ -0,0 +1,68 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <u/parsing.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// Comma-separated integers of 1 to 18 digits, a third of them negative, in
+// the shape of the fields of an ingested record.
+std::string make_fields(std::size_t count)
+{
+	std::mt19937_64 random{42};
+	std::string fields;
+	for (std::size_t i{0}; i < count; ++i) {
+		const auto digits = 1 + random() % 18;
+		if (random() % 3 == 0)
+			fields += '-';
+		fields += static_cast<char>('1' + random() % 9);
+		for (std::size_t digit{1}; digit < digits; ++digit)
+			fields += static_cast<char>('0' + random() % 10);
+		fields += ',';
+	}
+	return fields;
+}
+
+}
+
+auto main() -> int
+{
+	constexpr std::size_t count{1'000'000};
+	const std::string fields = make_fields(count);
+	const char* const end = fields.data() + fields.size();
+
+	std::vector<const char*> starts;
+	for (const char* at = fields.data(); at != end; ++at)
+		if (at == fields.data() || at[-1] == ',')
+			starts.push_back(at);
+
+	constexpr std::size_t iterations{50'000'000};
+
+	benchmarking::measure("u::parse", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		const auto parsed = u::parse<std::int64_t>(
+			std::string_view{at, static_cast<std::size_t>(end - at)});
+		benchmarking::do_not_optimize(parsed->value);
+	});
+
+	benchmarking::measure("std::from_chars", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		std::int64_t value{0};
+		std::from_chars(at, end, value);
+		benchmarking::do_not_optimize(value);
+	});
+
+	benchmarking::measure("strtoll", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		const long long value = std::strtoll(at, nullptr, 10);
+		benchmarking::do_not_optimize(value);
+	});
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <u/parsing.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// Comma-separated telemetry readings: mostly short fixed-point values, with
+// some printed to full precision in scientific notation.
+std::string make_fields(std::size_t count)
+{
+	std::mt19937_64 random{42};
+	std::uniform_real_distribution<double> readings{-1000.0, 1000.0};
+	std::string fields;
+	char buffer[32];
+	for (std::size_t i{0}; i < count; ++i) {
+		const double reading = readings(random);
+		if (random() % 4 == 0)
+			std::snprintf(buffer, sizeof(buffer), "%.17e,", reading);
+		else std::snprintf(buffer, sizeof(buffer), "%.3f,", reading);
+		fields += buffer;
+	}
+	return fields;
+}
+
+}
+
+auto main() -> int
+{
+	constexpr std::size_t count{1'000'000};
+	const std::string fields = make_fields(count);
+	const char* const end = fields.data() + fields.size();
+
+	std::vector<const char*> starts;
+	for (const char* at = fields.data(); at != end; ++at)
+		if (at == fields.data() || at[-1] == ',')
+			starts.push_back(at);
+
+	constexpr std::size_t iterations{50'000'000};
+
+	benchmarking::measure("u::parse<double>", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		const auto parsed = u::parse<double>(
+			std::string_view{at, static_cast<std::size_t>(end - at)});
+		benchmarking::do_not_optimize(parsed->value);
+	});
+
+	benchmarking::measure("std::from_chars", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		double value{0};
+		std::from_chars(at, end, value);
+		benchmarking::do_not_optimize(value);
+	});
+
+	benchmarking::measure("strtod", iterations, [&](std::size_t i) {
+		const char* const at = starts[i % count];
+		const double value = std::strtod(at, nullptr);
+		benchmarking::do_not_optimize(value);
+	});
+	return 0;
+}
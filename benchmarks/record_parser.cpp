@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <u/record_parser.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+std::string make_records(std::size_t count)
+{
+	std::mt19937_64 random{42};
+	std::string records;
+	for (std::size_t i{0}; i < count; ++i) {
+		records += std::to_string(static_cast<std::int64_t>(random() >> 16));
+		records += ',';
+		records += std::to_string(static_cast<double>(random() % 100'000) / 100);
+		records += i % 8 == 0 ? ",\"name, quoted\"\n" : ",name\n";
+	}
+	return records;
+}
+
+}
+
+auto main() -> int
+{
+	const std::string records = make_records(4'000'000);
+	const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+	double single{0};
+	for (unsigned threads{1}; threads <= cores; threads *= 2) {
+		const double nanoseconds = benchmarking::measure(
+			("parse_records, threads: " + std::to_string(threads)).c_str(),
+			8,
+			[&](std::size_t) {
+				auto table = u::parse_records<
+					std::int64_t,
+					double,
+					std::string_view>(records, {}, threads);
+				benchmarking::do_not_optimize(table);
+			});
+		if (threads == 1)
+			single = nanoseconds;
+		std::printf(
+			"%-48s %10.3f GB/s, %.2fx\n",
+			"",
+			static_cast<double>(records.size()) / nanoseconds,
+			single / nanoseconds);
+	}
+	return 0;
+}
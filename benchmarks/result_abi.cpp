@@ -0,0 +1,71 @@
+#include <memory>
+
+#include <u/diagnostics/result.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+// The same payload twice: once opted into trivial relocation, which gives
+// the result the trivial_abi layout, and once left out, which keeps the
+// union layout returned through a hidden pointer.
+struct relocatable_box
+{
+	std::unique_ptr<int> pointer;
+};
+
+struct box
+{
+	std::unique_ptr<int> pointer;
+};
+
+}
+
+template<>
+struct u::is_trivially_relocatable<relocatable_box>
+	: std::bool_constant<true>
+{};
+
+namespace
+{
+
+template<typename Box>
+[[gnu::noinline]]
+u::result<Box, int> make(int* pointer, std::size_t i)
+{
+	if (i % 1024 == 1023) [[unlikely]]
+		return u::error{static_cast<int>(i)};
+	return Box{std::unique_ptr<int>{pointer}};
+}
+
+template<typename Box>
+[[gnu::noinline]]
+int* forward(u::result<Box, int> result)
+{
+	if (!result.has_value()) [[unlikely]]
+		return nullptr;
+	return result->pointer.release();
+}
+
+template<typename Box>
+void run(const char* name)
+{
+	int storage{0};
+	benchmarking::measure(name, 100'000'000, [&](std::size_t i) {
+		int* pointer = forward<Box>(make<Box>(&storage, i));
+		benchmarking::do_not_optimize(pointer);
+	});
+}
+
+}
+
+auto main() -> int
+{
+	static_assert(sizeof(u::result<relocatable_box, int>) == 16);
+	static_assert(sizeof(u::result<box, int>) == 16);
+
+	run<box>("result<box, int> (union layout)");
+	run<relocatable_box>("result<relocatable_box, int> (trivial_abi)");
+	return 0;
+}
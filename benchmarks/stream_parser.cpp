@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <u/stream_parser.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+constexpr std::size_t segment_size{1460};
+
+std::string make_record(std::size_t count)
+{
+	std::mt19937_64 random{42};
+	std::string record;
+	for (std::size_t i{0}; i < count; ++i)
+		record += std::to_string(static_cast<std::int64_t>(random() >> 8)) + ',';
+	return record;
+}
+
+// Delivers the record in segments and parses the numbers as they arrive.
+std::int64_t stream(std::string_view record)
+{
+	u::stream_parser<std::int64_t> parser;
+	std::int64_t sum{0};
+	for (std::size_t at{0}; at < record.size(); at += segment_size) {
+		std::string_view chunk = record.substr(at, segment_size);
+		while (auto number = parser.parse(chunk)) {
+			sum += number->value();
+			chunk.remove_prefix(parser.consumed() + 1);
+		}
+	}
+	return sum;
+}
+
+// Appends each segment to a buffer and parses the record again from the
+// start, until it is complete.
+std::int64_t reparse(std::string_view record)
+{
+	std::string buffer;
+	std::int64_t sum{0};
+	for (std::size_t at{0}; at < record.size(); at += segment_size) {
+		buffer += record.substr(at, segment_size);
+		sum = 0;
+		std::string_view rest{buffer};
+		while (!rest.empty()) {
+			const auto number = u::parse<std::int64_t>(rest);
+			if (number->length == rest.size())
+				break;
+			sum += number->value;
+			rest.remove_prefix(number->length + 1);
+		}
+	}
+	return sum;
+}
+
+}
+
+auto main() -> int
+{
+	for (const std::size_t count : {1'000, 10'000, 100'000}) {
+		const std::string record = make_record(count);
+		const std::size_t iterations{10'000'000 / count};
+		const auto label = std::to_string(count) + " numbers";
+
+		benchmarking::measure(
+			("stream_parser, " + label).c_str(),
+			iterations,
+			[&](std::size_t) { benchmarking::do_not_optimize(stream(record)); });
+		benchmarking::measure(
+			("buffer and reparse, " + label).c_str(),
+			iterations / 10 + 1,
+			[&](std::size_t) { benchmarking::do_not_optimize(reparse(record)); });
+	}
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <cstdint>
+
+#include <u/diagnostics/trying.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+struct decode_error
+{
+	std::uint32_t offset;
+};
+
+constexpr std::uint32_t failure_period{1024};
+
+// Each variant decodes through the same eight-deep call chain; only the
+// way failures travel up the chain differs.
+
+template<int Depth>
+[[gnu::noinline]]
+u::result<std::uint32_t, decode_error> manual(std::uint32_t input)
+{
+	if constexpr (Depth == 0) {
+		if (input % failure_period == 0) [[unlikely]]
+			return u::error{decode_error{input}};
+		return input;
+	} else {
+		auto result = manual<Depth - 1>(input);
+		if (!result.has_value())
+			return u::error{result.error()};
+		return *result + Depth;
+	}
+}
+
+template<int Depth>
+[[gnu::noinline]]
+u::result<std::uint32_t, decode_error> trying(std::uint32_t input)
+{
+	if constexpr (Depth == 0) {
+		if (input % failure_period == 0) [[unlikely]]
+			return u::error{decode_error{input}};
+		return input;
+	} else return U_TRY(trying<Depth - 1>(input)) + Depth;
+}
+
+template<int Depth>
+[[gnu::noinline]]
+std::uint32_t throwing(std::uint32_t input)
+{
+	if constexpr (Depth == 0) {
+		if (input % failure_period == 0) [[unlikely]]
+			throw decode_error{input};
+		return input;
+	} else return throwing<Depth - 1>(input) + Depth;
+}
+
+}
+
+auto main() -> int
+{
+	constexpr std::size_t iterations{50'000'000};
+
+	benchmarking::measure("manual checks", iterations, [](std::size_t i) {
+		auto result = manual<8>(static_cast<std::uint32_t>(i));
+		benchmarking::do_not_optimize(result);
+	});
+
+	benchmarking::measure("U_TRY", iterations, [](std::size_t i) {
+		auto result = trying<8>(static_cast<std::uint32_t>(i));
+		benchmarking::do_not_optimize(result);
+	});
+
+	benchmarking::measure("exceptions", iterations, [](std::size_t i) {
+		try {
+			auto value = throwing<8>(static_cast<std::uint32_t>(i));
+			benchmarking::do_not_optimize(value);
+		} catch (const decode_error& error) {
+			benchmarking::do_not_optimize(error.offset);
+		}
+	});
+	return 0;
+}
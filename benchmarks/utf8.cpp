@@ -0,0 +1,74 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <u/utf8.h>
+
+#include "benchmarking.h"
+
+namespace
+{
+
+constexpr std::size_t size{1 << 20};
+
+std::string make_text(double non_ascii)
+{
+	std::mt19937_64 random{42};
+	std::bernoulli_distribution pick{non_ascii};
+	const std::string_view others[]{"\xc3\xa9", "\xe2\x82\xac", "\xe4\xb8\xad", "\xf0\x9f\x98\x80"};
+	std::string text;
+	while (text.size() < size)
+		text += pick(random) ? others[random() % 4] : std::string_view{"e"};
+	return text;
+}
+
+// Decodes one character at a time, as a validator written by hand does.
+bool validate_by_byte(std::string_view text)
+{
+	for (std::size_t i{0}; i < text.size();) {
+		const auto lead = static_cast<unsigned char>(text[i]);
+		std::size_t length = lead < 0x80 ? 1 : lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : lead < 0xF5 ? 4 : 0;
+		if (length == 0 || text.size() - i < length)
+			return false;
+		std::uint32_t code_point = length == 1 ? lead : lead & (0x7F >> length);
+		for (std::size_t k{1}; k < length; ++k) {
+			const auto byte = static_cast<unsigned char>(text[i + k]);
+			if ((byte & 0xC0) != 0x80)
+				return false;
+			code_point = code_point << 6 | (byte & 0x3F);
+		}
+		if ((length == 3 && code_point < 0x800)
+				|| (length == 4 && (code_point < 0x10000 || code_point > 0x10FFFF))
+				|| (code_point >= 0xD800 && code_point <= 0xDFFF))
+			return false;
+		i += length;
+	}
+	return true;
+}
+
+void report(const char* name, double nanoseconds)
+{ std::printf("%-48s %10.3f GB/s\n", name, static_cast<double>(size) / nanoseconds); }
+
+}
+
+auto main() -> int
+{
+	for (const double non_ascii : {0.0, 0.01, 0.1, 0.5}) {
+		const std::string text = make_text(non_ascii);
+		const auto label = std::to_string(static_cast<int>(non_ascii * 100)) + "% not ASCII";
+
+		report(
+			("u::validate_utf8, " + label).c_str(),
+			benchmarking::measure(("u::validate_utf8, " + label).c_str(), 2'000, [&](std::size_t) {
+				benchmarking::do_not_optimize(u::validate_utf8(text));
+			}));
+		report(
+			("by byte, " + label).c_str(),
+			benchmarking::measure(("by byte, " + label).c_str(), 200, [&](std::size_t) {
+				benchmarking::do_not_optimize(validate_by_byte(text));
+			}));
+	}
+	return 0;
+}
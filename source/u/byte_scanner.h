@@ -0,0 +1,295 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_BYTE_SCANNER_H
+
+#include <u/config.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#if defined __SSSE3__
+#	include <immintrin.h>
+#endif
+
+namespace u
+{
+
+// A set of bytes to scan for, as the tables of a lookup on each half of a
+// byte. The low half picks the high halves it is in the set with, and the
+// high half picks the bit of those it is: a byte is in the set when the two
+// lookups share a bit. High halves 0 to 7 and 8 to 15 have a pair of tables
+// each, so that every set is exact, however many bytes it has.
+class byte_set
+{
+public:
+	constexpr byte_set() noexcept = default;
+
+	constexpr explicit byte_set(std::string_view bytes) noexcept
+	{
+		for (const char c : bytes) {
+			const unsigned byte = static_cast<unsigned char>(c);
+			this->m_low[byte >> 7][byte & 0x0F] |= byte_set::m_bit(byte);
+		}
+		for (unsigned high{0}; high < 16; ++high)
+			this->m_high[high >> 3][high] = byte_set::m_bit(high << 4);
+		this->m_has_high_bytes = false;
+		for (const std::uint8_t bits : this->m_low[1])
+			this->m_has_high_bytes = this->m_has_high_bytes || bits != 0;
+	}
+
+	[[nodiscard]]
+	constexpr bool contains(char c) const noexcept
+	{
+		const unsigned byte = static_cast<unsigned char>(c);
+		return (this->m_low[byte >> 7][byte & 0x0F] & byte_set::m_bit(byte)) != 0;
+	}
+
+	// Which of the 64 bytes of `block` are in the set, the first in the
+	// lowest bit.
+	[[nodiscard]]
+	constexpr std::uint64_t match(const char* block) const noexcept
+	{
+#if defined __AVX2__
+		if (!std::is_constant_evaluated())
+			return this->m_match_avx2(block);
+#elif defined __SSSE3__
+		if (!std::is_constant_evaluated())
+			return this->m_match_ssse3(block);
+#endif
+		std::uint64_t matches{0};
+		for (std::size_t i{0}; i < 64; ++i)
+			matches |= std::uint64_t{this->contains(block[i])} << i;
+		return matches;
+	}
+
+private:
+	alignas(16) std::array<std::array<std::uint8_t, 16>, 2> m_low{};
+	alignas(16) std::array<std::array<std::uint8_t, 16>, 2> m_high{};
+	// Whether any byte of the set is past 0x7F, without which the second
+	// pair of tables is not looked up.
+	bool m_has_high_bytes{false};
+
+	static constexpr std::uint8_t m_bit(unsigned byte) noexcept
+	{ return static_cast<std::uint8_t>(1u << (byte >> 4 & 7)); }
+
+#if defined __AVX2__
+	[[nodiscard]]
+	__m256i m_match_half(__m256i bytes, std::size_t tables) const noexcept
+	{
+		const auto load = [](const std::array<std::uint8_t, 16>& table) {
+			return _mm256_broadcastsi128_si256(
+				_mm_load_si128(reinterpret_cast<const __m128i*>(table.data())));
+		};
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+		const __m256i low = _mm256_shuffle_epi8(
+			load(this->m_low[tables]),
+			_mm256_and_si256(bytes, nibble));
+		const __m256i high = _mm256_shuffle_epi8(
+			load(this->m_high[tables]),
+			_mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+		return _mm256_and_si256(low, high);
+	}
+
+	[[nodiscard]]
+	std::uint64_t m_match_avx2(const char* block) const noexcept
+	{
+		std::uint64_t matches{0};
+		for (std::size_t half{0}; half < 2; ++half) {
+			const __m256i bytes = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(block + 32 * half));
+			__m256i found = this->m_match_half(bytes, 0);
+			if (this->m_has_high_bytes)
+				found = _mm256_or_si256(found, this->m_match_half(bytes, 1));
+			matches |= std::uint64_t{static_cast<std::uint32_t>(
+				_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					found,
+					_mm256_setzero_si256())))} << (32 * half);
+		}
+		return ~matches;
+	}
+#elif defined __SSSE3__
+	[[nodiscard]]
+	__m128i m_match_quarter(__m128i bytes, std::size_t tables) const noexcept
+	{
+		const auto load = [](const std::array<std::uint8_t, 16>& table) {
+			return _mm_load_si128(reinterpret_cast<const __m128i*>(table.data()));
+		};
+		const __m128i nibble = _mm_set1_epi8(0x0F);
+		const __m128i low = _mm_shuffle_epi8(
+			load(this->m_low[tables]),
+			_mm_and_si128(bytes, nibble));
+		const __m128i high = _mm_shuffle_epi8(
+			load(this->m_high[tables]),
+			_mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+		return _mm_and_si128(low, high);
+	}
+
+	[[nodiscard]]
+	std::uint64_t m_match_ssse3(const char* block) const noexcept
+	{
+		std::uint64_t matches{0};
+		for (std::size_t quarter{0}; quarter < 4; ++quarter) {
+			const __m128i bytes = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(block + 16 * quarter));
+			__m128i found = this->m_match_quarter(bytes, 0);
+			if (this->m_has_high_bytes)
+				found = _mm_or_si128(found, this->m_match_quarter(bytes, 1));
+			matches |= std::uint64_t{static_cast<std::uint16_t>(
+				_mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128())))}
+				<< (16 * quarter);
+		}
+		return ~matches;
+	}
+#endif
+};
+
+namespace detail::byte_scanner_helpers
+{
+
+// The bytes of `set` in the 64 bytes of `input` from `first`, or in those
+// left before its end, without reading past it.
+[[nodiscard]]
+constexpr std::uint64_t match_block(
+	std::string_view input,
+	std::size_t first,
+	const u::byte_set& set) noexcept
+{
+	const std::size_t left = input.size() - first;
+	if (left >= 64)
+		return set.match(input.data() + first);
+
+	char padded[64]{};
+	for (std::size_t i{0}; i < left; ++i)
+		padded[i] = input[first + i];
+	return set.match(padded) & ((std::uint64_t{1} << left) - 1);
+}
+
+}  // namespace detail::byte_scanner_helpers
+
+// The offset of the first byte of `set` in `input` from `first`, or the size
+// of the input if there is none. Unlike `memchr`, any number of bytes is
+// looked for at once, 64 bytes of the input at a time.
+[[nodiscard]]
+constexpr std::size_t find_first_of(
+	std::string_view input,
+	const u::byte_set& set,
+	std::size_t first = 0) noexcept
+{
+	for (; first < input.size(); first += 64) {
+		const std::uint64_t matches =
+			detail::byte_scanner_helpers::match_block(input, first, set);
+		if (matches != 0)
+			return first + static_cast<std::size_t>(std::countr_zero(matches));
+	}
+	return input.size();
+}
+
+// The offsets of every byte of a set in an input, in order. Each block of
+// 64 bytes is matched once, and its matches are taken from the mask one at
+// a time:
+//
+//	constexpr u::byte_set delimiters{",\n\"\\"};
+//	for (const std::size_t offset : u::byte_scanner{text, delimiters})
+//		handle(text[offset]);
+class byte_scanner
+{
+public:
+	class iterator;
+
+	constexpr byte_scanner(std::string_view input, const u::byte_set& set) noexcept
+		: m_input{input},
+		  m_set{&set}
+	{}
+
+	// Returns the offset of the next byte of the set and moves past it, or
+	// returns the size of the input at its end.
+	[[nodiscard]]
+	constexpr std::size_t next() noexcept
+	{
+		while (this->m_matches == 0) {
+			if (this->m_next_block >= this->m_input.size())
+				return this->m_input.size();
+			this->m_block = this->m_next_block;
+			this->m_matches = detail::byte_scanner_helpers::match_block(
+				this->m_input,
+				this->m_block,
+				*this->m_set);
+			this->m_next_block += 64;
+		}
+		const std::size_t offset = this->m_block
+			+ static_cast<std::size_t>(std::countr_zero(this->m_matches));
+		this->m_matches &= this->m_matches - 1;
+		return offset;
+	}
+
+	[[nodiscard]]
+	constexpr iterator begin() noexcept;
+
+	[[nodiscard]]
+	constexpr std::default_sentinel_t end() const noexcept
+	{ return {}; }
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	constexpr std::string_view input() const noexcept
+	{ return this->m_input; }
+
+private:
+	std::string_view m_input;
+	const u::byte_set* m_set;
+	std::size_t m_block{0};
+	std::size_t m_next_block{0};
+	std::uint64_t m_matches{0};
+};
+
+class byte_scanner::iterator
+{
+public:
+	using value_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	constexpr iterator() noexcept = default;
+
+	constexpr explicit iterator(u::byte_scanner& scanner) noexcept
+		: m_scanner{&scanner},
+		  m_offset{scanner.next()}
+	{}
+
+	[[nodiscard]]
+	constexpr std::size_t operator*() const noexcept
+	{ return this->m_offset; }
+
+	constexpr iterator& operator++() noexcept
+	{
+		this->m_offset = this->m_scanner->next();
+		return *this;
+	}
+
+	constexpr void operator++(int) noexcept
+	{ ++*this; }
+
+	[[nodiscard]]
+	friend constexpr bool operator==(
+		const iterator& it,
+		std::default_sentinel_t) noexcept
+	{ return it.m_offset == it.m_scanner->input().size(); }
+
+private:
+	u::byte_scanner* m_scanner{nullptr};
+	std::size_t m_offset{0};
+};
+
+constexpr byte_scanner::iterator byte_scanner::begin() noexcept
+{ return iterator{*this}; }
+
+}
@@ -15,12 +15,55 @@
 
 #define U_ENABLE_UNPREFIXED_MACROS
 
+#if __has_cpp_attribute(clang::trivial_abi)
+#	define U_TRIVIAL_ABI [[clang::trivial_abi]]
+#else
+#	define U_TRIVIAL_ABI
+#endif
+
 #if !defined U_THROW
 #if __cpp_exceptions
 #	define U_THROW(v) (throw (v))
 #else
-#	defined U_THROW(v) (__builtin_abort())
+#	define U_THROW(v) (__builtin_abort())
+#endif
+#endif
+
+// How a result checks an access to its value by default: `value()` follows
+// `U_RESULT_VALUE_ACCESS` and `operator*` and `operator->` follow
+// `U_RESULT_DEREFERENCE_ACCESS`. A failed check throws, traps, is assumed
+// never to happen, or traps only when `NDEBUG` is not defined. The defaults
+// are part of the definition of `result`, so they are set for a whole
+// program, the same way in every translation unit; a single access takes
+// another policy as `value<U_ACCESS_ASSUME>()`.
+#define U_ACCESS_THROW 1
+#define U_ACCESS_TRAP 2
+#define U_ACCESS_ASSUME 3
+#define U_ACCESS_ASSERT 4
+
+#if !defined U_RESULT_VALUE_ACCESS
+#	define U_RESULT_VALUE_ACCESS U_ACCESS_THROW
+#endif
+
+#if !defined U_RESULT_DEREFERENCE_ACCESS
+#	define U_RESULT_DEREFERENCE_ACCESS U_ACCESS_ASSERT
 #endif
+
+// Whether making a result from a `u::error` counts the error at the site
+// where it is made, for `u::error_counts` to report. Set the same way in
+// every translation unit of a program; when it is not set, counting costs
+// nothing at all.
+#if !defined U_COUNT_RESULT_ERRORS
+#	define U_COUNT_RESULT_ERRORS 0
+#endif
+
+// One in how many results made from a `u::error` on a thread records the
+// stack of the thread, for `u::error_traces` to report, or 0 for none.
+// `u::set_error_trace_period` changes it while the program runs. Set the
+// same way in every translation unit of a program, which is built with
+// frame pointers for the stacks to be complete.
+#if !defined U_SAMPLE_RESULT_ERRORS
+#	define U_SAMPLE_RESULT_ERRORS 0
 #endif
 
 #if defined U_ENABLE_UNPREFIXED_MACROS
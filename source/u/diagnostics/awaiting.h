@@ -0,0 +1,201 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_AWAITING_H
+
+#include <u/config.h>
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <u/diagnostics/result.h>
+
+// Lets a function returning `u::result` be written as a coroutine in which
+// `co_await` yields the value of a result or returns its error:
+//
+//	u::result<request, error> decode(std::string_view input)
+//	{
+//		auto header = co_await decode_header(input);
+//		auto body = co_await decode_body(input, header);
+//		co_return request{header, body};
+//	}
+//
+// Such a coroutine never suspends for real, so once it is inlined Clang can
+// see the whole lifetime of the frame and elide its allocation. Frames that
+// are not elided go through `u::result_frame_allocator`.
+//
+// It is slow, and not a replacement for `U_TRY` on hot paths: built with the
+// GCC, which never elides the frame, a chain of eight `co_await`s took about
+// six times as long as the same checks written by hand (see
+// benchmarks/await.cpp). Elision narrows the gap under Clang, but parity
+// has not been shown. Use it where readability matters more than speed.
+//
+// The object returned by `get_return_object` is converted to the result when
+// the coroutine first returns to its caller, as Clang 17 and the GCC do.
+// Older compilers convert it before the body runs, and are rejected.
+
+#if defined __clang_major__ && __clang_major__ < 17
+#	error u/diagnostics/awaiting.h needs Clang 17 or newer (CWG2563)
+#endif
+
+namespace u
+{
+
+// Allocates the frames of coroutines returning `result<ValueType,
+// ErrorType>` whose allocation was not elided. Specialize it to route them
+// to a pool or an arena.
+template<typename ValueType, typename ErrorType>
+struct result_frame_allocator
+{
+	[[nodiscard]]
+	static void* allocate(std::size_t size)
+	{ return ::operator new(size); }
+
+	static void deallocate(void* frame, std::size_t size) noexcept
+	{ ::operator delete(frame, size); }
+};
+
+namespace detail::await_helpers
+{
+
+template<typename ValueType, typename ErrorType>
+class promise;
+
+template<typename ValueType, typename ErrorType>
+class return_object
+{
+public:
+	using result_type = u::result<ValueType, ErrorType>;
+	using promise_type = promise<ValueType, ErrorType>;
+
+	explicit return_object(promise_type& promise) noexcept
+		: m_coroutine{
+			std::coroutine_handle<promise_type>::from_promise(promise)}
+	{ promise.m_slot = std::addressof(this->m_result); }
+
+	return_object(const return_object&) = delete;
+	return_object& operator=(const return_object&) = delete;
+
+	~return_object()
+	{ this->m_coroutine.destroy(); }
+
+	operator result_type()
+	{ return std::move(*this->m_result); }
+
+private:
+	std::coroutine_handle<promise_type> m_coroutine;
+	std::optional<result_type> m_result;
+};
+
+template<typename Result, typename Promise>
+struct awaiter
+{
+	Result&& m_result;
+
+	[[nodiscard]]
+	constexpr bool await_ready() const noexcept
+	{ return this->m_result.has_value(); }
+
+	void await_suspend(std::coroutine_handle<Promise> coroutine)
+	{
+		coroutine.promise().m_slot->emplace(
+			u::error_tag,
+			std::forward<Result>(this->m_result).error());
+	}
+
+	constexpr decltype(auto) await_resume() noexcept
+	{ return *std::forward<Result>(this->m_result); }
+};
+
+template<typename ValueType, typename ErrorType>
+class promise_base
+{
+public:
+	using result_type = u::result<ValueType, ErrorType>;
+
+	[[nodiscard]]
+	static void* operator new(std::size_t size)
+	{
+		return u::result_frame_allocator<ValueType, ErrorType>
+			::allocate(size);
+	}
+
+	static void operator delete(void* frame, std::size_t size) noexcept
+	{
+		u::result_frame_allocator<ValueType, ErrorType>
+			::deallocate(frame, size);
+	}
+
+	[[nodiscard]]
+	constexpr std::suspend_never initial_suspend() const noexcept
+	{ return {}; }
+
+	// The frame outlives the body so that the return object, which sees
+	// every path out of the coroutine, is the one that destroys it.
+	[[nodiscard]]
+	constexpr std::suspend_always final_suspend() const noexcept
+	{ return {}; }
+
+	[[noreturn]]
+	void unhandled_exception()
+	{ throw; }
+
+protected:
+	template<typename, typename>
+	friend class return_object;
+
+	template<typename, typename>
+	friend struct awaiter;
+
+	std::optional<result_type>* m_slot;
+};
+
+template<typename ValueType, typename ErrorType>
+class promise
+	: public promise_base<ValueType, ErrorType>
+{
+public:
+	[[nodiscard]]
+	return_object<ValueType, ErrorType> get_return_object() noexcept
+	{ return return_object<ValueType, ErrorType>{*this}; }
+
+	// Ending a coroutine returning `result<void, E>` takes `co_return {};`,
+	// since a promise cannot provide both `return_value` and `return_void`.
+	template<typename T = std::conditional_t<
+		std::is_void_v<ValueType>,
+		typename promise::result_type,
+		ValueType>>
+		requires std::is_constructible_v<
+			typename promise::result_type,
+			T>
+	void return_value(T&& value)
+	noexcept(std::is_nothrow_constructible_v<
+		typename promise::result_type,
+		T>)
+	{ this->m_slot->emplace(std::forward<T>(value)); }
+
+	template<typename Result>
+		requires u::is_result_v<std::remove_cvref_t<Result>>
+			&& std::is_constructible_v<
+				ErrorType,
+				decltype(std::declval<Result>().error())>
+	[[nodiscard]]
+	awaiter<Result, promise> await_transform(Result&& result) noexcept
+	{ return {std::forward<Result>(result)}; }
+};
+
+}  // namespace detail::await_helpers
+
+}
+
+template<typename ValueType, typename ErrorType, typename... Ts>
+struct std::coroutine_traits<u::result<ValueType, ErrorType>, Ts...>
+{
+	using promise_type =
+		u::detail::await_helpers::promise<ValueType, ErrorType>;
+};
@@ -0,0 +1,400 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_CHAINING_H
+
+#include <u/config.h>
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <u/diagnostics/result.h>
+
+// Lazy pipelines over `u::result`:
+//
+//	u::result<header, error> parsed = std::move(frame)
+//		| u::check(validate_checksum)
+//		| u::then(decode_header)
+//		| u::map(normalize)
+//		| u::map_error(to_error);
+//
+// Nothing runs until the pipeline is converted to a result. The stages then
+// run in one pass which tests the discriminant once for the source and once
+// per stage that can fail, and which hands the value and the error down by
+// reference, so the payload is moved only into the final result.
+//
+// The pipeline refers to its source and must be converted in the expression
+// that builds it.
+
+namespace u
+{
+
+namespace detail::chain_helpers
+{
+
+// Passes the value on to the function which produces the next result.
+template<typename F>
+struct then_stage
+{
+	F m_fn;
+};
+
+// Passes the value on to the function which produces the next value.
+template<typename F>
+struct map_stage
+{
+	F m_fn;
+};
+
+// Passes the error on to the function which produces the next error.
+template<typename F>
+struct map_error_stage
+{
+	F m_fn;
+};
+
+// Passes the value on to the function which returns a `result<void, E>`,
+// and keeps the value if that succeeds.
+template<typename F>
+struct check_stage
+{
+	F m_fn;
+};
+
+template<typename T>
+constexpr bool is_stage_v = false;
+
+template<typename F>
+constexpr bool is_stage_v<then_stage<F>> = true;
+
+template<typename F>
+constexpr bool is_stage_v<map_stage<F>> = true;
+
+template<typename F>
+constexpr bool is_stage_v<map_error_stage<F>> = true;
+
+template<typename F>
+constexpr bool is_stage_v<check_stage<F>> = true;
+
+// What flows into a stage: `ValueArgument` is the type the value is passed
+// as (`void` when there is none) and `ErrorArgument` is the type the error
+// is passed as.
+template<typename ValueType, typename ValueArgument, typename ErrorArgument>
+struct state
+{
+	using value_type = ValueType;
+	using value_argument = ValueArgument;
+	using error_argument = ErrorArgument;
+	using error_type = std::remove_cvref_t<ErrorArgument>;
+};
+
+template<typename T>
+using value_argument_t = std::conditional_t<
+	std::is_void_v<typename std::remove_cvref_t<T>::value_type>,
+	void,
+	decltype(*std::declval<T>())>;
+
+template<typename Source>
+using initial_state_t = state<
+	typename std::remove_cvref_t<Source>::value_type,
+	value_argument_t<Source>,
+	decltype(std::declval<Source>().error())>;
+
+template<typename F, typename Argument>
+struct invoke_with
+	: std::invoke_result<F, Argument>
+{};
+
+template<typename F>
+struct invoke_with<F, void>
+	: std::invoke_result<F>
+{};
+
+template<typename F, typename Argument>
+using invoke_with_t = typename invoke_with<F, Argument>::type;
+
+template<typename Stage, typename State>
+struct next_state;
+
+template<typename F, typename State>
+struct next_state<then_stage<F>, State>
+{
+	using result_type = std::remove_cvref_t<
+		invoke_with_t<F, typename State::value_argument>>;
+
+	static_assert(u::is_result_v<result_type>);
+	static_assert(std::is_same_v<
+		typename result_type::error_type,
+		typename State::error_type>);
+
+	using type = state<
+		typename result_type::value_type,
+		value_argument_t<result_type>,
+		std::common_reference_t<
+			typename State::error_argument,
+			decltype(std::declval<result_type>().error())>>;
+};
+
+template<typename F, typename State>
+struct next_state<map_stage<F>, State>
+{
+	using value_type = std::remove_cvref_t<
+		invoke_with_t<F, typename State::value_argument>>;
+
+	using type = state<
+		value_type,
+		std::conditional_t<
+			std::is_void_v<value_type>,
+			void,
+			std::add_rvalue_reference_t<value_type>>,
+		typename State::error_argument>;
+};
+
+template<typename F, typename State>
+struct next_state<map_error_stage<F>, State>
+{
+	using error_type = std::remove_cvref_t<
+		std::invoke_result_t<F, typename State::error_argument>>;
+
+	static_assert(u::is_valid_error_v<error_type>);
+
+	using type = state<
+		typename State::value_type,
+		typename State::value_argument,
+		error_type&&>;
+};
+
+template<typename F, typename State>
+struct next_state<check_stage<F>, State>
+{
+	using result_type = std::remove_cvref_t<
+		invoke_with_t<F, typename State::value_argument>>;
+
+	static_assert(u::is_result_v<result_type>);
+	static_assert(std::is_void_v<typename result_type::value_type>);
+	static_assert(std::is_same_v<
+		typename result_type::error_type,
+		typename State::error_type>);
+
+	using type = state<
+		typename State::value_type,
+		typename State::value_argument,
+		std::common_reference_t<
+			typename State::error_argument,
+			decltype(std::declval<result_type>().error())>>;
+};
+
+template<std::size_t Index, typename State, typename... Stages>
+struct state_at
+{
+	using type = State;
+};
+
+template<std::size_t Index, typename State, typename Stage, typename... Stages>
+	requires (Index != 0)
+struct state_at<Index, State, Stage, Stages...>
+	: state_at<
+		Index - 1,
+		typename next_state<Stage, State>::type,
+		Stages...>
+{};
+
+template<std::size_t Index, typename State, typename... Stages>
+using state_at_t = typename state_at<Index, State, Stages...>::type;
+
+template<typename Source, typename... Stages>
+class chain
+{
+	using final_state =
+		state_at_t<sizeof...(Stages), initial_state_t<Source>, Stages...>;
+
+	template<std::size_t Index>
+	using m_state_t = state_at_t<Index, initial_state_t<Source>, Stages...>;
+
+public:
+	using result_type = u::result<
+		typename final_state::value_type,
+		typename final_state::error_type>;
+
+	constexpr chain(Source&& source, std::tuple<Stages...>&& stages) noexcept
+		: m_source{std::forward<Source>(source)},
+		  m_stages{std::move(stages)}
+	{}
+
+	chain(const chain&) = delete;
+	chain& operator=(const chain&) = delete;
+
+	template<typename Stage>
+		requires is_stage_v<std::remove_cvref_t<Stage>>
+	[[nodiscard]]
+	constexpr auto operator|(Stage&& stage) &&
+	{
+		return chain<Source, Stages..., std::remove_cvref_t<Stage>>{
+			std::forward<Source>(this->m_source),
+			std::tuple_cat(
+				std::move(this->m_stages),
+				std::tuple<std::remove_cvref_t<Stage>>{
+					std::forward<Stage>(stage)})};
+	}
+
+	[[nodiscard]]
+	constexpr result_type evaluate() &&
+	{
+		auto&& source = std::forward<Source>(this->m_source);
+		if (!source.has_value())
+			return this->m_on_error<0>(std::forward<Source>(source).error());
+		if constexpr (std::is_void_v<
+				typename std::remove_cvref_t<Source>::value_type>)
+			return this->m_on_value<0>();
+		else return this->m_on_value<0>(*std::forward<Source>(source));
+	}
+
+	[[nodiscard]]
+	constexpr operator result_type() &&
+	{ return std::move(*this).evaluate(); }
+
+private:
+	Source&& m_source;
+	std::tuple<Stages...> m_stages;
+
+	template<std::size_t Index, typename... Ts>
+	constexpr result_type m_on_value(Ts&&... value)
+	{
+		if constexpr (Index == sizeof...(Stages)) {
+			return result_type{std::in_place, std::forward<Ts>(value)...};
+		} else {
+			auto&& stage = std::get<Index>(this->m_stages);
+			return this->m_run_value<Index>(
+				std::move(stage),
+				std::forward<Ts>(value)...);
+		}
+	}
+
+	template<std::size_t Index, typename F, typename... Ts>
+	constexpr result_type m_run_value(then_stage<F>&& stage, Ts&&... value)
+	{
+		auto next = std::invoke(
+			std::move(stage.m_fn),
+			std::forward<Ts>(value)...);
+		if (!next.has_value())
+			return this->m_on_error<Index + 1>(std::move(next).error());
+		if constexpr (std::is_void_v<
+				typename decltype(next)::value_type>)
+			return this->m_on_value<Index + 1>();
+		else return this->m_on_value<Index + 1>(*std::move(next));
+	}
+
+	template<std::size_t Index, typename F, typename... Ts>
+	constexpr result_type m_run_value(map_stage<F>&& stage, Ts&&... value)
+	{
+		if constexpr (std::is_void_v<
+				invoke_with_t<F, typename m_state_t<Index>::value_argument>>) {
+			std::invoke(std::move(stage.m_fn), std::forward<Ts>(value)...);
+			return this->m_on_value<Index + 1>();
+		} else {
+			return this->m_on_value<Index + 1>(std::invoke(
+				std::move(stage.m_fn),
+				std::forward<Ts>(value)...));
+		}
+	}
+
+	template<std::size_t Index, typename F, typename... Ts>
+	constexpr result_type m_run_value(const map_error_stage<F>&, Ts&&... value)
+	{ return this->m_on_value<Index + 1>(std::forward<Ts>(value)...); }
+
+	template<std::size_t Index, typename F, typename... Ts>
+	constexpr result_type m_run_value(check_stage<F>&& stage, Ts&&... value)
+	{
+		auto status = std::invoke(
+			std::move(stage.m_fn),
+			std::as_const(value)...);
+		if (!status.has_value())
+			return this->m_on_error<Index + 1>(std::move(status).error());
+		return this->m_on_value<Index + 1>(std::forward<Ts>(value)...);
+	}
+
+	template<std::size_t Index, typename T>
+	constexpr result_type m_on_error(T&& error)
+	{
+		using error_argument = typename m_state_t<Index>::error_argument;
+
+		if constexpr (Index == sizeof...(Stages)) {
+			return result_type{
+				u::error_tag,
+				static_cast<error_argument>(error)};
+		} else {
+			auto&& stage = std::get<Index>(this->m_stages);
+			return this->m_run_error<Index>(
+				std::move(stage),
+				static_cast<error_argument>(error));
+		}
+	}
+
+	template<std::size_t Index, typename Stage, typename T>
+	constexpr result_type m_run_error(const Stage&, T&& error)
+	{ return this->m_on_error<Index + 1>(std::forward<T>(error)); }
+
+	template<std::size_t Index, typename F, typename T>
+	constexpr result_type m_run_error(map_error_stage<F>&& stage, T&& error)
+	{
+		return this->m_on_error<Index + 1>(std::invoke(
+			std::move(stage.m_fn),
+			std::forward<T>(error)));
+	}
+};
+
+}  // namespace detail::chain_helpers
+
+// Continues with `fn(value)`, which returns a result with the same error.
+template<typename F>
+[[nodiscard]]
+constexpr auto then(F&& fn)
+{
+	return detail::chain_helpers::then_stage<std::decay_t<F>>{
+		std::forward<F>(fn)};
+}
+
+// Replaces the value with `fn(value)`.
+template<typename F>
+[[nodiscard]]
+constexpr auto map(F&& fn)
+{
+	return detail::chain_helpers::map_stage<std::decay_t<F>>{
+		std::forward<F>(fn)};
+}
+
+// Replaces the error with `fn(error)`.
+template<typename F>
+[[nodiscard]]
+constexpr auto map_error(F&& fn)
+{
+	return detail::chain_helpers::map_error_stage<std::decay_t<F>>{
+		std::forward<F>(fn)};
+}
+
+// Fails with the error of `fn(value)`, which returns a `result<void, E>`,
+// and otherwise keeps the value untouched.
+template<typename F>
+[[nodiscard]]
+constexpr auto check(F&& fn)
+{
+	return detail::chain_helpers::check_stage<std::decay_t<F>>{
+		std::forward<F>(fn)};
+}
+
+template<typename Source, typename Stage>
+	requires u::is_result_v<std::remove_cvref_t<Source>>
+		&& detail::chain_helpers::is_stage_v<std::remove_cvref_t<Stage>>
+[[nodiscard]]
+constexpr auto operator|(Source&& source, Stage&& stage)
+{
+	return detail::chain_helpers::chain<Source, std::remove_cvref_t<Stage>>{
+		std::forward<Source>(source),
+		std::tuple<std::remove_cvref_t<Stage>>{std::forward<Stage>(stage)}};
+}
+
+}
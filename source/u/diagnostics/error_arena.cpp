@@ -0,0 +1,105 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#include <u/diagnostics/error_arena.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace u
+{
+
+namespace
+{
+
+// The size of the first block, which holds a few hundred short messages.
+constexpr std::size_t first_block_size{16 * 1024};
+
+}
+
+error_arena::~error_arena()
+{
+	for (block* it = this->m_first; it != nullptr;) {
+		block* const next = it->next;
+		std::free(it);
+		it = next;
+	}
+}
+
+void error_arena::reset() noexcept
+{
+	this->m_current = this->m_first;
+	if (this->m_current == nullptr)
+		return;
+	this->m_next = this->m_current->begin();
+	this->m_end = this->m_current->end();
+}
+
+std::size_t error_arena::used() const noexcept
+{
+	std::size_t used{0};
+	for (block* it = this->m_first; it != this->m_current; it = it->next)
+		used += it->size;
+	if (this->m_current != nullptr)
+		used += static_cast<std::size_t>(this->m_next - this->m_current->begin());
+	return used;
+}
+
+std::size_t error_arena::capacity() const noexcept
+{
+	std::size_t capacity{0};
+	for (block* it = this->m_first; it != nullptr; it = it->next)
+		capacity += it->size;
+	return capacity;
+}
+
+void* error_arena::m_grow(std::size_t size) noexcept
+{
+	// Blocks kept from before a reset are filled in again first. One too
+	// small for `size` is skipped, and left for after the next reset.
+	block* previous = this->m_current;
+	block* next = previous != nullptr ? previous->next : this->m_first;
+	while (next != nullptr && next->size < size) {
+		previous = next;
+		next = next->next;
+	}
+
+	if (next == nullptr) {
+		const std::size_t block_size = std::max(
+			{size, first_block_size, 2 * this->capacity()});
+		void* const memory = std::aligned_alloc(
+			alignment,
+			sizeof(block) + block_size);
+		if (memory == nullptr)
+			return nullptr;
+		next = ::new (memory) block{nullptr, block_size};
+		if (previous != nullptr)
+			previous->next = next;
+		else this->m_first = next;
+	}
+
+	this->m_current = next;
+	this->m_next = next->begin() + size;
+	this->m_end = next->end();
+	return next->begin();
+}
+
+error_ref error_ref::m_lost() noexcept
+{
+	static constexpr char message[]{
+		"the message of this error was lost: the error arena could not grow"};
+	struct lost_record
+	{
+		detail::error_record record;
+		char text[sizeof(message)];
+	};
+	static const lost_record lost = [] {
+		lost_record lost{{sizeof(message) - 1}, {}};
+		std::copy(std::begin(message), std::end(message), lost.text);
+		return lost;
+	}();
+	return error_ref{&lost.record};
+}
+
+}
@@ -0,0 +1,185 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_ERROR_ARENA_H
+
+#include <u/config.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+namespace u
+{
+
+// A bump allocator for the payloads of errors, one per thread. Allocating
+// moves a pointer, and memory is only taken from the system when the arena
+// grows, which it does to the most it has held at once and then stops.
+// Nothing is freed one allocation at a time: `reset` rewinds the whole
+// arena at a point where no payload in it is referred to any more, such as
+// the end of a request:
+//
+//	auto response = handle(request);
+//	u::error_arena::current().reset();
+class error_arena
+{
+public:
+	error_arena() noexcept = default;
+
+	error_arena(const error_arena&) = delete;
+	error_arena& operator=(const error_arena&) = delete;
+
+	~error_arena();
+
+	// The arena of the calling thread.
+	[[nodiscard]]
+	static error_arena& current() noexcept
+	{
+		static thread_local error_arena arena;
+		return arena;
+	}
+
+	// Returns `size` bytes aligned to `alignof(std::max_align_t)`, or null
+	// if the arena could not grow.
+	[[nodiscard]]
+	void* allocate(std::size_t size) noexcept
+	{
+		size = (size + alignment - 1) & ~(alignment - 1);
+		if (static_cast<std::size_t>(this->m_end - this->m_next) < size) [[unlikely]]
+			return this->m_grow(size);
+		void* const memory = this->m_next;
+		this->m_next += size;
+		return memory;
+	}
+
+	// Frees everything allocated since the last reset, and keeps the memory
+	// for what is allocated next.
+	void reset() noexcept;
+
+	//
+	// Observers
+	//
+
+	// The number of bytes allocated since the last reset.
+	[[nodiscard]]
+	std::size_t used() const noexcept;
+
+	// The number of bytes the arena holds.
+	[[nodiscard]]
+	std::size_t capacity() const noexcept;
+
+private:
+	static constexpr std::size_t alignment{alignof(std::max_align_t)};
+
+	// Blocks are kept in a list in the order they are filled in.
+	struct block
+	{
+		block* next;
+		std::size_t size;
+
+		[[nodiscard]]
+		std::byte* begin() noexcept
+		{ return reinterpret_cast<std::byte*>(this) + sizeof(block); }
+
+		[[nodiscard]]
+		std::byte* end() noexcept
+		{ return this->begin() + this->size; }
+	};
+	static_assert(sizeof(block) % alignment == 0);
+
+	block* m_first{nullptr};
+	block* m_current{nullptr};
+	std::byte* m_next{nullptr};
+	std::byte* m_end{nullptr};
+
+	[[gnu::cold]]
+	void* m_grow(std::size_t size) noexcept;
+};
+
+namespace detail
+{
+
+struct error_record
+{
+	std::size_t size;
+
+	[[nodiscard]]
+	const char* data() const noexcept
+	{ return reinterpret_cast<const char*>(this + 1); }
+};
+
+}  // namespace detail
+
+// An error message kept in the error arena of the thread which made it. It
+// is a single pointer, and trivially copyable, so that a
+// `u::result<T, u::error_ref>` is returned in registers, and making one
+// does not call `malloc` once the arena has grown. It refers to the arena
+// and must not be used after the arena is reset.
+class error_ref
+{
+public:
+	// An empty message.
+	constexpr error_ref() noexcept = default;
+
+	// Copies the pieces of the message, one after another, into the error
+	// arena of the calling thread. If the arena cannot grow, the message is
+	// replaced by one which says so.
+	template<typename... Ts>
+		requires (std::convertible_to<const Ts&, std::string_view> && ...)
+	[[nodiscard]]
+	static error_ref make(const Ts&... pieces) noexcept
+	{
+		const std::string_view views[]{std::string_view{pieces}..., {}};
+		std::size_t size{0};
+		for (const std::string_view piece : views)
+			size += piece.size();
+
+		void* const memory = u::error_arena::current().allocate(
+			sizeof(detail::error_record) + size + 1);
+		if (memory == nullptr) [[unlikely]]
+			return error_ref::m_lost();
+
+		auto* const record = ::new (memory) detail::error_record{size};
+		char* text = reinterpret_cast<char*>(record + 1);
+		for (const std::string_view piece : views) {
+			if (!piece.empty())
+				std::memcpy(text, piece.data(), piece.size());
+			text += piece.size();
+		}
+		*text = '\0';
+		return error_ref{record};
+	}
+
+	//
+	// Observers
+	//
+
+	// The message, which is also terminated by a null character.
+	[[nodiscard]]
+	std::string_view message() const noexcept
+	{
+		if (this->m_record == nullptr)
+			return {};
+		return std::string_view{this->m_record->data(), this->m_record->size};
+	}
+
+	[[nodiscard]]
+	constexpr bool empty() const noexcept
+	{ return this->m_record == nullptr; }
+
+private:
+	const detail::error_record* m_record{nullptr};
+
+	constexpr explicit error_ref(const detail::error_record* record) noexcept
+		: m_record{record}
+	{}
+
+	[[nodiscard]]
+	static error_ref m_lost() noexcept;
+};
+
+}
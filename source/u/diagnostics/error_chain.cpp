@@ -0,0 +1,46 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#include <u/diagnostics/error_chain.h>
+
+#include <charconv>
+
+namespace u
+{
+
+std::string error_chain::to_string() const
+{
+	std::string out;
+	this->format_to(out);
+	return out;
+}
+
+void error_chain::format_to(std::string& out) const
+{
+	bool first{true};
+	for (const u::error_context& context : *this) {
+		if (!first)
+			out += ": ";
+		first = false;
+
+		out += context.what;
+		if (!context.key.empty()) {
+			out += context.what.empty() ? "in \"" : " in \"";
+			out += context.key;
+			out += '"';
+		}
+		if (context.offset != u::error_context::npos) {
+			char digits[20];
+			const auto end = std::to_chars(
+				digits,
+				digits + sizeof(digits),
+				context.offset).ptr;
+			out += context.what.empty() && context.key.empty()
+				? "at offset "
+				: " at offset ";
+			out.append(digits, end);
+		}
+	}
+}
+
+}
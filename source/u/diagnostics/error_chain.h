@@ -0,0 +1,200 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_ERROR_CHAIN_H
+
+#include <u/config.h>
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include <u/diagnostics/chaining.h>
+#include <u/diagnostics/error_arena.h>
+
+// Errors to which each layer that passes them on adds its context:
+//
+//	u::result<header, u::error_chain> read_header(std::string_view text)
+//	{
+//		return parse_fields(text)
+//			| u::with_context({.what = "while reading the header"});
+//	}
+//
+// The context is kept as it is given, in a frame in the error arena, and
+// no message is formatted until `to_string` is called. An error which is
+// only counted costs a few stores per layer.
+
+namespace u
+{
+
+// The context of an error at one layer. `what` is not copied and must
+// outlive the error, as a string literal does; `key` is copied.
+struct error_context
+{
+	std::string_view what{};
+	// The name of what was being handled, such as a field or a file.
+	std::string_view key{};
+	// Where in the input, or `npos` for nowhere in particular.
+	std::size_t offset{npos};
+
+	static constexpr std::size_t npos{static_cast<std::size_t>(-1)};
+};
+
+namespace detail
+{
+
+struct error_frame
+{
+	const error_frame* cause;
+	u::error_context context;
+};
+
+}  // namespace detail
+
+// An error as a chain of contexts, from the layer which last passed it on
+// down to the one where it occurred. It is a single pointer to the newest
+// frame, and trivially copyable. The frames are in the error arena of the
+// thread which made them, and the chain must not be used after the arena
+// is reset.
+class error_chain
+{
+public:
+	class iterator;
+
+	// An error with no context.
+	constexpr error_chain() noexcept = default;
+
+	// An error where it occurred.
+	[[nodiscard]]
+	static error_chain make(const u::error_context& context) noexcept
+	{ return error_chain{}.with(context); }
+
+	// This error passed on by a layer with `context`. If the error arena
+	// cannot grow, the context is left out.
+	[[nodiscard]]
+	error_chain with(const u::error_context& context) const noexcept
+	{
+		const std::size_t key_size = context.key.size();
+		void* const memory = u::error_arena::current().allocate(
+			sizeof(detail::error_frame) + key_size);
+		if (memory == nullptr) [[unlikely]]
+			return *this;
+
+		std::string_view key{};
+		if (key_size != 0) {
+			char* const copy = static_cast<char*>(memory)
+				+ sizeof(detail::error_frame);
+			std::memcpy(copy, context.key.data(), key_size);
+			key = std::string_view{copy, key_size};
+		}
+		return error_chain{::new (memory) detail::error_frame{
+			this->m_frame,
+			u::error_context{context.what, key, context.offset}}};
+	}
+
+	// Formats the message, from the outermost context to the innermost:
+	//
+	//	while reading the header: in "host" at offset 17: invalid character
+	[[nodiscard]]
+	std::string to_string() const;
+
+	// Appends the message to `out`.
+	void format_to(std::string& out) const;
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	constexpr bool empty() const noexcept
+	{ return this->m_frame == nullptr; }
+
+	// The context where the error occurred, which tells errors apart for
+	// counting without formatting them.
+	[[nodiscard]]
+	u::error_context root_cause() const noexcept
+	{
+		const detail::error_frame* frame = this->m_frame;
+		if (frame == nullptr)
+			return {};
+		while (frame->cause != nullptr)
+			frame = frame->cause;
+		return frame->context;
+	}
+
+	// The contexts from the outermost to the innermost.
+	[[nodiscard]]
+	iterator begin() const noexcept;
+
+	[[nodiscard]]
+	std::default_sentinel_t end() const noexcept
+	{ return {}; }
+
+private:
+	const detail::error_frame* m_frame{nullptr};
+
+	constexpr explicit error_chain(const detail::error_frame* frame) noexcept
+		: m_frame{frame}
+	{}
+};
+
+class error_chain::iterator
+{
+public:
+	using value_type = u::error_context;
+	using difference_type = std::ptrdiff_t;
+
+	iterator() noexcept = default;
+
+	explicit iterator(const detail::error_frame* frame) noexcept
+		: m_frame{frame}
+	{}
+
+	[[nodiscard]]
+	const u::error_context& operator*() const noexcept
+	{ return this->m_frame->context; }
+
+	[[nodiscard]]
+	const u::error_context* operator->() const noexcept
+	{ return &this->m_frame->context; }
+
+	iterator& operator++() noexcept
+	{
+		this->m_frame = this->m_frame->cause;
+		return *this;
+	}
+
+	iterator operator++(int) noexcept
+	{
+		iterator previous = *this;
+		++*this;
+		return previous;
+	}
+
+	[[nodiscard]]
+	friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+	{ return it.m_frame == nullptr; }
+
+private:
+	const detail::error_frame* m_frame{nullptr};
+};
+
+inline error_chain::iterator error_chain::begin() const noexcept
+{ return iterator{this->m_frame}; }
+
+// Adds `context` to the error of a pipeline:
+//
+//	return std::move(parsed) | u::with_context({.what = "while reading the body"});
+[[nodiscard]]
+inline auto with_context(const u::error_context& context) noexcept
+{
+	return u::map_error([context](const u::error_chain& error) noexcept {
+		return error.with(context);
+	});
+}
+
+}
@@ -0,0 +1,224 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#include <u/diagnostics/error_counters.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace u
+{
+
+namespace
+{
+
+// A counter for a site. Sites are told apart on a thread by the address of
+// the name of their file, which is quick to compare but may differ between
+// translation units for the same file.
+struct site_counter
+{
+	const char* file{nullptr};
+	std::uint_least32_t line{0};
+	std::uint_least32_t column{0};
+	std::source_location site;
+	std::atomic<std::uint64_t> count{0};
+};
+
+// Sites are told apart in the totals by the name of their file.
+using totals = std::map<
+	std::tuple<std::string_view, std::uint_least32_t, std::uint_least32_t>,
+	u::error_site_count>;
+
+// The counters of one thread, in a table with open addressing. Only the
+// thread adds to the table, under the lock, and only it writes the
+// counters, so that neither finding a counter nor incrementing it takes the
+// lock, and another thread may read them while holding it.
+class thread_table
+{
+public:
+	std::mutex mutex;
+
+	thread_table();
+	~thread_table();
+
+	// The counter for `site`, or null if there was none and no memory for
+	// one.
+	[[nodiscard]]
+	std::atomic<std::uint64_t>* find(const std::source_location& site) noexcept
+	{
+		const char* const file = site.file_name();
+		const std::uint_least32_t line = site.line();
+		const std::uint_least32_t column = site.column();
+		for (std::size_t i = thread_table::m_hash(file, line, column);; ++i) {
+			site_counter& counter = this->m_counters[i & this->m_mask];
+			if (counter.file == file
+					&& counter.line == line
+					&& counter.column == column)
+				return &counter.count;
+			if (counter.file == nullptr) [[unlikely]]
+				return this->m_insert(site);
+		}
+	}
+
+	// Adds the counts to `totals`. The lock must be held by the caller
+	// when it is not this thread.
+	void add_to(totals& totals) const
+	{
+		for (std::size_t i{0}; i <= this->m_mask; ++i) {
+			const site_counter& counter = this->m_counters[i];
+			if (counter.file == nullptr)
+				continue;
+			auto& total = totals.try_emplace(
+				{counter.file, counter.line, counter.column},
+				u::error_site_count{counter.site, 0}).first->second;
+			total.count += counter.count.load(std::memory_order_relaxed);
+		}
+	}
+
+private:
+	std::unique_ptr<site_counter[]> m_counters;
+	std::size_t m_mask{0};
+	std::size_t m_size{0};
+
+	static std::size_t m_hash(
+		const char* file,
+		std::uint_least32_t line,
+		std::uint_least32_t column) noexcept
+	{
+		const std::size_t hash = (reinterpret_cast<std::uintptr_t>(file)
+			^ (std::size_t{line} << 16 | column)) * 0x9E3779B97F4A7C15;
+		return hash >> 32;
+	}
+
+	// Places the counter for `site` in the first free slot after `hash`.
+	static site_counter& m_place(
+		site_counter* counters,
+		std::size_t mask,
+		const std::source_location& site) noexcept
+	{
+		for (std::size_t i = thread_table::m_hash(
+					site.file_name(),
+					site.line(),
+					site.column());;
+				++i) {
+			site_counter& counter = counters[i & mask];
+			if (counter.file != nullptr)
+				continue;
+			counter.file = site.file_name();
+			counter.line = site.line();
+			counter.column = site.column();
+			counter.site = site;
+			return counter;
+		}
+	}
+
+	[[gnu::cold]]
+	std::atomic<std::uint64_t>* m_insert(const std::source_location& site) noexcept;
+};
+
+// The tables of the threads which are running, and the counts of those which
+// have finished.
+struct registry
+{
+	std::mutex mutex;
+	std::vector<thread_table*> tables;
+	totals finished;
+
+	static registry& get() noexcept
+	{
+		// Never destroyed, since threads may finish after `main` returns.
+		static registry* const instance = new registry;
+		return *instance;
+	}
+};
+
+thread_table::thread_table()
+	: m_counters{std::make_unique<site_counter[]>(64)},
+	  m_mask{63}
+{
+	auto& threads = registry::get();
+	const std::lock_guard lock{threads.mutex};
+	threads.tables.push_back(this);
+}
+
+thread_table::~thread_table()
+{
+	auto& threads = registry::get();
+	const std::lock_guard lock{threads.mutex};
+	this->add_to(threads.finished);
+	std::erase(threads.tables, this);
+}
+
+std::atomic<std::uint64_t>* thread_table::m_insert(
+	const std::source_location& site) noexcept
+{
+	const std::lock_guard lock{this->mutex};
+
+	// The table is kept at most half full.
+	if (2 * (this->m_size + 1) > this->m_mask + 1) {
+		const std::size_t capacity = 2 * (this->m_mask + 1);
+		std::unique_ptr<site_counter[]> counters{
+			new (std::nothrow) site_counter[capacity]};
+		if (counters == nullptr)
+			return nullptr;
+		for (std::size_t i{0}; i <= this->m_mask; ++i) {
+			const site_counter& old = this->m_counters[i];
+			if (old.file != nullptr)
+				thread_table::m_place(counters.get(), capacity - 1, old.site)
+					.count.store(
+						old.count.load(std::memory_order_relaxed),
+						std::memory_order_relaxed);
+		}
+		this->m_counters = std::move(counters);
+		this->m_mask = capacity - 1;
+	}
+
+	++this->m_size;
+	return &thread_table::m_place(this->m_counters.get(), this->m_mask, site).count;
+}
+
+}
+
+std::vector<u::error_site_count> error_counts()
+{
+	auto& threads = registry::get();
+	const std::lock_guard lock{threads.mutex};
+
+	auto all = threads.finished;
+	for (thread_table* const table : threads.tables) {
+		const std::lock_guard table_lock{table->mutex};
+		table->add_to(all);
+	}
+
+	std::vector<u::error_site_count> counts;
+	counts.reserve(all.size());
+	for (const auto& [key, count] : all)
+		counts.push_back(count);
+	std::sort(counts.begin(), counts.end(), [](const auto& a, const auto& b) {
+		return a.count > b.count;
+	});
+	return counts;
+}
+
+void detail::count_error(const std::source_location& site) noexcept
+{
+	static thread_local thread_table table;
+
+	// Only this thread writes the counter, so an increment which is not
+	// atomic as a whole loses nothing.
+	std::atomic<std::uint64_t>* const count = table.find(site);
+	if (count != nullptr) [[likely]]
+		count->store(
+			count->load(std::memory_order_relaxed) + 1,
+			std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,47 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_ERROR_COUNTERS_H
+
+#include <u/config.h>
+
+#include <cstdint>
+#include <source_location>
+#include <vector>
+
+// Counts of the errors made at each site in a program, when it is built with
+// `U_COUNT_RESULT_ERRORS` set:
+//
+//	for (const u::error_site_count& site : u::error_counts())
+//		log("{}:{}: {} errors", site.site.file_name(), site.site.line(), site.count);
+//
+// Each thread counts in a table of its own, without atomic read-modify-write
+// operations or locks once it has seen a site, and the tables are only added
+// up when the counts are asked for.
+
+namespace u
+{
+
+struct error_site_count
+{
+	std::source_location site;
+	std::uint64_t count;
+};
+
+// The number of errors made at each site so far, by every thread, the most
+// frequent first.
+[[nodiscard]]
+std::vector<u::error_site_count> error_counts();
+
+namespace detail
+{
+
+// Counts an error made at `site`. The first error at a site on a thread
+// takes a lock; those after it increment a counter.
+[[gnu::cold]]
+void count_error(const std::source_location& site) noexcept;
+
+}  // namespace detail
+
+}
@@ -0,0 +1,191 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#include <u/diagnostics/error_traces.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+
+#include <pthread.h>
+
+namespace u
+{
+
+namespace
+{
+
+// The number of traces kept, of the latest errors recorded.
+constexpr std::size_t ring_size{256};
+
+// How many errors a thread counts before it looks at the period again while
+// no trace is recorded.
+constexpr std::uint32_t disabled_countdown{64 * 1024};
+
+// A trace in the ring. Its version is odd while it is written, and is read
+// before and after the trace to tell whether the trace was the same
+// throughout.
+struct slot
+{
+	std::atomic<std::uint64_t> version{0};
+	std::atomic<std::uint64_t> sequence{0};
+	std::atomic<std::size_t> depth{0};
+	std::array<std::atomic<const void*>, u::error_trace::max_depth> frames{};
+};
+
+constinit slot ring[ring_size];
+constinit std::atomic<std::uint64_t> next_sequence{0};
+// The period set while the program runs, or -1 for the one it was built
+// with.
+constinit std::atomic<std::int64_t> sample_period{-1};
+
+// The bounds of the stack of the calling thread, which keep the walk from
+// following a frame pointer that is not one, in code built without them.
+struct stack_bounds
+{
+	std::uintptr_t low{0};
+	std::uintptr_t high{0};
+
+	static const stack_bounds& current() noexcept
+	{
+		static constinit thread_local stack_bounds bounds;
+		if (bounds.high == 0) [[unlikely]] {
+			pthread_attr_t attributes;
+			if (pthread_getattr_np(pthread_self(), &attributes) != 0)
+				return bounds;
+			void* address{nullptr};
+			std::size_t size{0};
+			if (pthread_attr_getstack(&attributes, &address, &size) == 0) {
+				bounds.low = reinterpret_cast<std::uintptr_t>(address);
+				bounds.high = bounds.low + size;
+			}
+			pthread_attr_destroy(&attributes);
+		}
+		return bounds;
+	}
+};
+
+// Walks the frame pointers from `frame` outward, into `frames`, and returns
+// how many it found.
+[[gnu::always_inline]]
+inline std::size_t walk(
+	const void* frame,
+	std::array<const void*, u::error_trace::max_depth>& frames) noexcept
+{
+	const stack_bounds& bounds = stack_bounds::current();
+	std::size_t depth{0};
+	auto address = reinterpret_cast<std::uintptr_t>(frame);
+	while (depth < frames.size()
+			&& address % alignof(void*) == 0
+			&& address >= bounds.low
+			&& address + 2 * sizeof(void*) <= bounds.high) {
+		const auto* const pointers = reinterpret_cast<const void* const*>(address);
+		if (pointers[1] == nullptr)
+			break;
+		frames[depth++] = pointers[1];
+		// The stack grows down, so each caller's frame is above.
+		const auto caller = reinterpret_cast<std::uintptr_t>(pointers[0]);
+		if (caller <= address)
+			break;
+		address = caller;
+	}
+	return depth;
+}
+
+// Puts a trace in the next slot of the ring. A slot still being written by
+// a thread which has fallen a whole ring behind is left to it, and the
+// trace is dropped.
+void record(
+	const std::array<const void*, u::error_trace::max_depth>& frames,
+	std::size_t depth) noexcept
+{
+	const std::uint64_t sequence = next_sequence.fetch_add(1, std::memory_order_relaxed);
+	slot& slot = ring[sequence % ring_size];
+
+	std::uint64_t version = slot.version.load(std::memory_order_relaxed);
+	if (version % 2 != 0
+			|| !slot.version.compare_exchange_strong(
+				version,
+				version + 1,
+				std::memory_order_relaxed))
+		return;
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.sequence.store(sequence, std::memory_order_relaxed);
+	slot.depth.store(depth, std::memory_order_relaxed);
+	for (std::size_t i{0}; i < depth; ++i)
+		slot.frames[i].store(frames[i], std::memory_order_relaxed);
+	slot.version.store(version + 2, std::memory_order_release);
+}
+
+}
+
+std::vector<u::error_trace> error_traces()
+{
+	std::vector<u::error_trace> traces;
+	traces.reserve(ring_size);
+	for (const slot& slot : ring) {
+		const std::uint64_t version = slot.version.load(std::memory_order_acquire);
+		if (version == 0 || version % 2 != 0)
+			continue;
+
+		u::error_trace trace;
+		trace.sequence = slot.sequence.load(std::memory_order_relaxed);
+		trace.depth = std::min(
+			slot.depth.load(std::memory_order_relaxed),
+			u::error_trace::max_depth);
+		for (std::size_t i{0}; i < trace.depth; ++i)
+			trace.frames[i] = slot.frames[i].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.version.load(std::memory_order_relaxed) == version)
+			traces.push_back(trace);
+	}
+	std::sort(traces.begin(), traces.end(), [](const auto& a, const auto& b) {
+		return a.sequence < b.sequence;
+	});
+	return traces;
+}
+
+void dump_error_traces(std::FILE* file)
+{
+	for (const u::error_trace& trace : u::error_traces()) {
+		std::fprintf(file, "error trace %" PRIu64 ":\n", trace.sequence);
+		for (const void* const address : trace.addresses())
+			std::fprintf(file, "  %p\n", address);
+		std::fputc('\n', file);
+	}
+}
+
+void set_error_trace_period(std::uint32_t period) noexcept
+{ sample_period.store(period, std::memory_order_relaxed); }
+
+void detail::sample_error_trace(std::uint32_t built_period) noexcept
+{
+	const std::int64_t set_period = sample_period.load(std::memory_order_relaxed);
+	const auto period = set_period >= 0
+		? static_cast<std::uint32_t>(set_period)
+		: built_period;
+	if (period == 0) {
+		detail::error_trace_countdown = disabled_countdown;
+		return;
+	}
+	detail::error_trace_countdown = period;
+
+	static constinit thread_local bool started{false};
+	if (!started) {
+		started = true;
+		return;
+	}
+
+	std::array<const void*, u::error_trace::max_depth> frames;
+	record(frames, walk(__builtin_frame_address(0), frames));
+}
+
+void detail::record_error_trace() noexcept
+{
+	std::array<const void*, u::error_trace::max_depth> frames;
+	record(frames, walk(__builtin_frame_address(0), frames));
+}
+
+}
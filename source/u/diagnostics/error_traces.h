@@ -0,0 +1,87 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_ERROR_TRACES_H
+
+#include <u/config.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+// The stacks of a sample of the errors made in a program, when it is built
+// with `U_SAMPLE_RESULT_ERRORS` set to one in how many to record:
+//
+//	for (const u::error_trace& trace : u::error_traces())
+//		for (const void* address : trace.addresses())
+//			log("  {}", address);
+//
+// Each thread counts its errors down, and only the one which reaches zero
+// walks the frame pointers of the stack. Traces are kept in a ring of the
+// latest few hundred, which is written without locks and read by copying.
+// Every `u::bad_result_access` is recorded too, without sampling.
+
+namespace u
+{
+
+struct error_trace
+{
+	static constexpr std::size_t max_depth{32};
+
+	// The order in which the traces were recorded, from 0.
+	std::uint64_t sequence{0};
+	std::size_t depth{0};
+	// The return addresses, from the innermost frame outward.
+	std::array<const void*, max_depth> frames{};
+
+	[[nodiscard]]
+	constexpr std::span<const void* const> addresses() const noexcept
+	{ return {this->frames.data(), this->depth}; }
+};
+
+// The traces in the ring, the oldest first. A trace being written while
+// they are read is left out.
+[[nodiscard]]
+std::vector<u::error_trace> error_traces();
+
+// Writes the traces to `file`, one address to a line in the form which
+// `addr2line` reads, and a blank line after each trace.
+void dump_error_traces(std::FILE* file);
+
+// Records one in `period` errors from now on, or none for 0. Each thread
+// takes the new period once its current countdown ends.
+void set_error_trace_period(std::uint32_t period) noexcept;
+
+namespace detail
+{
+
+// The errors left on this thread until the next trace. It starts the same
+// whatever the period, so that every translation unit agrees on it, and the
+// first error on a thread only starts the countdown.
+inline constinit thread_local std::uint32_t error_trace_countdown{1};
+
+// Records the stack of the caller, and starts the next countdown, of
+// `built_period` unless another period was set. The first call on a thread
+// starts the countdown without recording.
+[[gnu::cold, gnu::noinline]]
+void sample_error_trace(std::uint32_t built_period) noexcept;
+
+// Records the stack of the caller.
+[[gnu::cold, gnu::noinline]]
+void record_error_trace() noexcept;
+
+// Counts an error down, and records the stack of every `period`th.
+[[gnu::always_inline]]
+inline void count_down_error_trace() noexcept
+{
+	if (--detail::error_trace_countdown == 0) [[unlikely]]
+		detail::sample_error_trace(U_SAMPLE_RESULT_ERRORS);
+}
+
+}  // namespace detail
+
+}
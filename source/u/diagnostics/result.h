@@ -6,13 +6,51 @@
 
 #include <u/config.h>
 
+#include <cstddef>
 #include <functional>
 #include <initializer_list>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include <u/metaprogramming.h>
+#include <u/niche.h>
+#include <u/relocation.h>
+
+#if U_COUNT_RESULT_ERRORS
+#	include <source_location>
+#	include <u/diagnostics/error_counters.h>
+#endif
+
+#if U_SAMPLE_RESULT_ERRORS
+#	include <u/diagnostics/error_traces.h>
+#endif
+
+// The site where a result is made from an error, as a defaulted last
+// parameter of the constructor, and the count of an error there. Neither
+// is anything when errors are not counted.
+#if U_COUNT_RESULT_ERRORS
+#	define U_DETAIL_ERROR_SITE \
+		, std::source_location site = std::source_location::current()
+#	define U_DETAIL_COUNT_ERROR() \
+		if (!std::is_constant_evaluated()) \
+			::u::detail::count_error(site)
+#else
+#	define U_DETAIL_ERROR_SITE
+#	define U_DETAIL_COUNT_ERROR() static_cast<void>(0)
+#endif
+
+// The countdown to the next trace of an error, which is nothing when errors
+// are not sampled.
+#if U_SAMPLE_RESULT_ERRORS
+#	define U_DETAIL_SAMPLE_ERROR() \
+		if (!std::is_constant_evaluated()) \
+			::u::detail::count_down_error_trace()
+#else
+#	define U_DETAIL_SAMPLE_ERROR() static_cast<void>(0)
+#endif
 
 namespace u
 {
@@ -66,7 +104,7 @@ template<typename T>
 struct is_valid_result
 	: std::bool_constant<
 		!u::is_error_v<std::remove_cvref_t<T>>
-		&& !std::is_reference_v<T>
+		&& !std::is_rvalue_reference_v<T>
 		&& !std::is_function_v<T>>
 {};
 
@@ -116,7 +154,8 @@ public:
 
 
 	explicit bad_result_access(error_type error)
-		: m_error{error} {}
+	noexcept(std::is_nothrow_move_constructible_v<error_type>)
+		: m_error{std::move(error)} {}
 
 	[[nodiscard]]
 	error_type& error() & noexcept
@@ -144,7 +183,7 @@ public:
 	constexpr error(error&&) = default;
 
 	template<typename T = ErrorType>
-		requires (!std::is_same_v<std::remove_cvref_t<T>, T>)
+		requires (!std::is_same_v<std::remove_cvref_t<T>, error>)
 			&& (!std::is_same_v<std::remove_cvref_t<T>, std::in_place_t>)
 			&& std::is_constructible_v<ErrorType, T>
 	constexpr explicit error(T&& error)
@@ -153,7 +192,7 @@ public:
 	{}
 
 	template<typename... Ts>
-	constexpr explicit error(std::in_place_t, Ts... args)
+	constexpr explicit error(std::in_place_t, Ts&&... args)
 	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
 		: m_error{std::forward<Ts>(args)...}
 	{}
@@ -219,6 +258,44 @@ template<typename T> error(T) -> error<T>;
 namespace detail::result_helpers
 {
 
+// Stands in for the value of `result<T&, E>`. It never holds null, which
+// leaves null free as a niche.
+template<typename T>
+struct reference
+{
+	reference() = default;
+
+	constexpr explicit reference(T* pointer) noexcept
+		: m_pointer{pointer}
+	{}
+
+	template<typename U>
+		requires std::is_convertible_v<U*, T*>
+	constexpr reference(const reference<U>& other) noexcept
+		: m_pointer{other.m_pointer}
+	{}
+
+	T* m_pointer;
+};
+
+}  // namespace detail::result_helpers
+
+template<typename T>
+struct niche_traits<detail::result_helpers::reference<T>>
+{
+	using reference = detail::result_helpers::reference<T>;
+
+	static constexpr void construct_niche(reference* storage) noexcept
+	{ std::construct_at(storage, nullptr); }
+
+	[[nodiscard]]
+	static constexpr bool is_niche(const reference* storage) noexcept
+	{ return storage->m_pointer == nullptr; }
+};
+
+namespace detail::result_helpers
+{
+
 template<typename Gaurded>
 	requires std::is_nothrow_move_constructible_v<Gaurded>
 struct guard
@@ -232,8 +309,8 @@ struct guard
 	{
 		if (this->m_target) [[unlikely]]
 			std::construct_at(
-				this->target,
-				std::move(this->temp));
+				this->m_target,
+				std::move(this->m_temp));
 	}
 
 	guard(const guard&) = delete;
@@ -257,23 +334,511 @@ noexcept(std::is_nothrow_constructible_v<New, Arg>)
 	if constexpr(std::is_nothrow_constructible_v<New, Arg>) {
 		std::destroy_at(old);
 		std::construct_at(new_, std::forward<Arg>(arg));
-		return;
-	} else if constexpr(std::is_nothrow_move_constructible_v<Arg>) {
-		New temp{std::forward<Arg>(arg)};
+	} else if constexpr(std::is_nothrow_move_constructible_v<New>) {
+		New temp(std::forward<Arg>(arg));
 		std::destroy_at(old);
 		std::construct_at(new_, std::move(temp));
-		return;
+	} else {
+		result_helpers::guard<Old> guard{*old};
+		std::construct_at(new_, std::forward<Arg>(arg));
+		guard.release();
 	}
+}
+
+// Forwards a member of `Storage` with the value category `Storage` was
+// passed with.
+template<typename Storage, typename T>
+constexpr auto&& forward_from(T& member) noexcept
+{
+	if constexpr (std::is_lvalue_reference_v<Storage>)
+		return member;
+	else return std::move(member);
+}
+
+// Throws the error of a result which has none, copied from an lvalue and
+// moved from an rvalue. It is outlined, once per error type, so that an
+// inlined access is a compare and a branch to a call.
+template<typename T>
+[[noreturn, gnu::cold, gnu::noinline]]
+void throw_bad_access([[maybe_unused]] T&& error)
+{
+#if U_SAMPLE_RESULT_ERRORS
+	detail::record_error_trace();
+#endif
+	U_THROW(u::bad_result_access<std::remove_cvref_t<T>>{std::forward<T>(error)});
+}
 
-	result_helpers::guard<Old> guard{*old};
-	std::construct_at(new_, std::forward<Arg>(arg));
-	guard.target = nullptr;
+// Checks an access to the value of a result as `Policy`, one of the
+// `U_ACCESS_*` macros, says. `fail` throws, and is only called when the
+// check fails.
+template<int Policy, typename F>
+[[gnu::always_inline]]
+constexpr void check_access(bool has_value, F&& fail)
+noexcept(Policy != U_ACCESS_THROW)
+{
+	static_assert(Policy == U_ACCESS_THROW
+		|| Policy == U_ACCESS_TRAP
+		|| Policy == U_ACCESS_ASSUME
+		|| Policy == U_ACCESS_ASSERT);
+
+	if constexpr (Policy == U_ACCESS_THROW) {
+		if (!has_value) [[unlikely]]
+			std::forward<F>(fail)();
+	} else if constexpr (Policy == U_ACCESS_TRAP) {
+		if (!has_value) [[unlikely]]
+			__builtin_trap();
+	} else if constexpr (Policy == U_ACCESS_ASSUME) {
+#if __has_builtin(__builtin_assume)
+		__builtin_assume(has_value);
+#endif
+		if (!has_value)
+			__builtin_unreachable();
+	} else {
+#if !defined NDEBUG
+		if (!has_value) [[unlikely]]
+			__builtin_trap();
+#endif
+	}
 }
 
+// Stands in for the value of `result<void, E>`.
+struct unit
+{};
+
+struct from_storage_t
+{
+	explicit from_storage_t() = default;
+};
+
+inline constexpr from_storage_t from_storage{};
+
+// The discriminant is a separate flag next to a union of both
+// alternatives.
+template<typename ValueType, typename ErrorType>
+struct tagged_storage
+{
+	template<typename... Ts>
+	constexpr explicit tagged_storage(std::in_place_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
+		: m_value(std::forward<Ts>(args)...),
+		  m_has_value{true}
+	{}
+
+	template<typename... Ts>
+	constexpr explicit tagged_storage(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_error(std::forward<Ts>(args)...),
+		  m_has_value{false}
+	{}
+
+	template<typename Storage>
+	constexpr explicit tagged_storage(from_storage_t, Storage&& other)
+		: m_has_value{other.has_value()}
+	{
+		if (this->m_has_value)
+			std::construct_at(
+				std::addressof(this->m_value),
+				result_helpers::forward_from<Storage>(other.value()));
+		else std::construct_at(
+			std::addressof(this->m_error),
+			result_helpers::forward_from<Storage>(other.error()));
+	}
+
+	constexpr tagged_storage(const tagged_storage&)
+		requires std::is_trivially_copy_constructible_v<ValueType>
+			&& std::is_trivially_copy_constructible_v<ErrorType>
+	= default;
+
+	constexpr tagged_storage(const tagged_storage& other)
+	noexcept(std::is_nothrow_copy_constructible_v<ValueType>
+		&& std::is_nothrow_copy_constructible_v<ErrorType>)
+		requires std::is_copy_constructible_v<ValueType>
+			&& std::is_copy_constructible_v<ErrorType>
+			&& (!std::is_trivially_copy_constructible_v<ValueType>
+				|| !std::is_trivially_copy_constructible_v<ErrorType>)
+		: tagged_storage{from_storage, other}
+	{}
+
+	constexpr tagged_storage(tagged_storage&&)
+		requires std::is_trivially_move_constructible_v<ValueType>
+			&& std::is_trivially_move_constructible_v<ErrorType>
+	= default;
+
+	constexpr tagged_storage(tagged_storage&& other)
+	noexcept(std::is_nothrow_move_constructible_v<ValueType>
+		&& std::is_nothrow_move_constructible_v<ErrorType>)
+		requires std::is_move_constructible_v<ValueType>
+			&& std::is_move_constructible_v<ErrorType>
+			&& (!std::is_trivially_move_constructible_v<ValueType>
+				|| !std::is_trivially_move_constructible_v<ErrorType>)
+		: tagged_storage{from_storage, std::move(other)}
+	{}
+
+	constexpr ~tagged_storage()
+		requires std::is_trivially_destructible_v<ValueType>
+			&& std::is_trivially_destructible_v<ErrorType>
+	= default;
+
+	constexpr ~tagged_storage()
+		requires (!std::is_trivially_destructible_v<ValueType>
+			|| !std::is_trivially_destructible_v<ErrorType>)
+	{
+		if (this->m_has_value)
+			std::destroy_at(std::addressof(this->m_value));
+		else std::destroy_at(std::addressof(this->m_error));
+	}
+
+	// Only ever used when both alternatives are trivially assignable;
+	// `result` handles every other case itself.
+	constexpr tagged_storage& operator=(const tagged_storage&) = default;
+	constexpr tagged_storage& operator=(tagged_storage&&) = default;
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_has_value; }
+
+	[[nodiscard]]
+	constexpr ValueType& value() noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr const ValueType& value() const noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr ErrorType& error() noexcept
+	{ return this->m_error; }
+
+	[[nodiscard]]
+	constexpr const ErrorType& error() const noexcept
+	{ return this->m_error; }
+
+	template<typename T>
+	constexpr void emplace_value(T&& value)
+	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
+	{
+		result_helpers::reconstruct(
+			std::addressof(this->m_value),
+			std::addressof(this->m_error),
+			std::forward<T>(value));
+		this->m_has_value = true;
+	}
+
+	template<typename T>
+	constexpr void emplace_error(T&& error)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+	{
+		result_helpers::reconstruct(
+			std::addressof(this->m_error),
+			std::addressof(this->m_value),
+			std::forward<T>(error));
+		this->m_has_value = false;
+	}
+
+	union {
+		ValueType m_value;
+		ErrorType m_error;
+	};
+	bool m_has_value;
+};
+
+// An alternative that is empty and trivial carries no information other
+// than its presence, so it can be encoded as a niche of the other one.
+template<typename T>
+constexpr bool is_niche_filler_v =
+	std::is_empty_v<T>
+	&& std::is_trivially_copyable_v<T>
+	&& std::is_trivially_default_constructible_v<T>;
+
+// The discriminant is a niche of the value, which is occupied exactly when
+// the result holds the (empty) error.
+template<typename ValueType, typename ErrorType>
+	requires u::has_niche_v<ValueType>
+		&& is_niche_filler_v<ErrorType>
+struct value_niche_storage
+{
+	using traits = u::niche_traits<ValueType>;
+
+	template<typename... Ts>
+	constexpr explicit value_niche_storage(std::in_place_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
+		: m_value(std::forward<Ts>(args)...)
+	{}
+
+	template<typename... Ts>
+	constexpr explicit value_niche_storage(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_error(std::forward<Ts>(args)...)
+	{ traits::construct_niche(std::addressof(this->m_value)); }
+
+	template<typename Storage>
+	constexpr explicit value_niche_storage(from_storage_t, Storage&& other)
+	{
+		if (other.has_value())
+			std::construct_at(
+				std::addressof(this->m_value),
+				result_helpers::forward_from<Storage>(other.value()));
+		else this->emplace_error(result_helpers::forward_from<Storage>(other.error()));
+	}
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return !traits::is_niche(std::addressof(this->m_value)); }
+
+	[[nodiscard]]
+	constexpr ValueType& value() noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr const ValueType& value() const noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr ErrorType& error() noexcept
+	{ return this->m_error; }
+
+	[[nodiscard]]
+	constexpr const ErrorType& error() const noexcept
+	{ return this->m_error; }
+
+	template<typename T>
+	constexpr void emplace_value(T&& value)
+	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
+	{ std::construct_at(std::addressof(this->m_value), std::forward<T>(value)); }
+
+	template<typename T>
+	constexpr void emplace_error(T&& error)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+	{
+		std::construct_at(std::addressof(this->m_error), std::forward<T>(error));
+		traits::construct_niche(std::addressof(this->m_value));
+	}
+
+	ValueType m_value;
+	[[no_unique_address]] ErrorType m_error;
+};
+
+// The mirror image of `value_niche_storage`: the discriminant is a niche of
+// the error, which is occupied exactly when the result holds the (empty)
+// value.
+template<typename ValueType, typename ErrorType>
+	requires is_niche_filler_v<ValueType>
+		&& u::has_niche_v<ErrorType>
+struct error_niche_storage
+{
+	using traits = u::niche_traits<ErrorType>;
+
+	template<typename... Ts>
+	constexpr explicit error_niche_storage(std::in_place_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
+		: m_value(std::forward<Ts>(args)...)
+	{ traits::construct_niche(std::addressof(this->m_error)); }
+
+	template<typename... Ts>
+	constexpr explicit error_niche_storage(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_error(std::forward<Ts>(args)...)
+	{}
+
+	template<typename Storage>
+	constexpr explicit error_niche_storage(from_storage_t, Storage&& other)
+	{
+		if (other.has_value())
+			this->emplace_value(result_helpers::forward_from<Storage>(other.value()));
+		else std::construct_at(
+			std::addressof(this->m_error),
+			result_helpers::forward_from<Storage>(other.error()));
+	}
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return traits::is_niche(std::addressof(this->m_error)); }
+
+	[[nodiscard]]
+	constexpr ValueType& value() noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr const ValueType& value() const noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr ErrorType& error() noexcept
+	{ return this->m_error; }
+
+	[[nodiscard]]
+	constexpr const ErrorType& error() const noexcept
+	{ return this->m_error; }
+
+	template<typename T>
+	constexpr void emplace_value(T&& value)
+	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
+	{
+		std::construct_at(std::addressof(this->m_value), std::forward<T>(value));
+		traits::construct_niche(std::addressof(this->m_error));
+	}
+
+	template<typename T>
+	constexpr void emplace_error(T&& error)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+	{ std::construct_at(std::addressof(this->m_error), std::forward<T>(error)); }
+
+	[[no_unique_address]] ValueType m_value;
+	ErrorType m_error;
+};
+
+// The payload lives in raw bytes so that no member has a non-trivial
+// special member function, which lets `[[clang::trivial_abi]]` take effect
+// and the result be passed and returned in registers. Moving the bytes is
+// only sound because both alternatives are trivially relocatable.
+template<typename ValueType, typename ErrorType>
+struct U_TRIVIAL_ABI relocatable_storage
+{
+	template<typename... Ts>
+	explicit relocatable_storage(std::in_place_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
+		: m_has_value{true}
+	{
+		std::construct_at(
+			reinterpret_cast<ValueType*>(this->m_bytes),
+			std::forward<Ts>(args)...);
+	}
+
+	template<typename... Ts>
+	explicit relocatable_storage(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_has_value{false}
+	{
+		std::construct_at(
+			reinterpret_cast<ErrorType*>(this->m_bytes),
+			std::forward<Ts>(args)...);
+	}
+
+	template<typename Storage>
+	explicit relocatable_storage(from_storage_t, Storage&& other)
+		: m_has_value{other.has_value()}
+	{
+		if (this->m_has_value)
+			std::construct_at(
+				reinterpret_cast<ValueType*>(this->m_bytes),
+				result_helpers::forward_from<Storage>(other.value()));
+		else std::construct_at(
+			reinterpret_cast<ErrorType*>(this->m_bytes),
+			result_helpers::forward_from<Storage>(other.error()));
+	}
+
+	relocatable_storage(const relocatable_storage& other)
+	noexcept(std::is_nothrow_copy_constructible_v<ValueType>
+		&& std::is_nothrow_copy_constructible_v<ErrorType>)
+		requires std::is_copy_constructible_v<ValueType>
+			&& std::is_copy_constructible_v<ErrorType>
+		: relocatable_storage{from_storage, other}
+	{}
+
+	relocatable_storage(relocatable_storage&& other)
+	noexcept(std::is_nothrow_move_constructible_v<ValueType>
+		&& std::is_nothrow_move_constructible_v<ErrorType>)
+		requires std::is_move_constructible_v<ValueType>
+			&& std::is_move_constructible_v<ErrorType>
+		: relocatable_storage{from_storage, std::move(other)}
+	{}
+
+	~relocatable_storage()
+	{
+		if (this->m_has_value)
+			std::destroy_at(std::addressof(this->value()));
+		else std::destroy_at(std::addressof(this->error()));
+	}
+
+	relocatable_storage& operator=(const relocatable_storage&) = delete;
+
+	[[nodiscard]]
+	bool has_value() const noexcept
+	{ return this->m_has_value; }
+
+	[[nodiscard]]
+	ValueType& value() noexcept
+	{ return *std::launder(reinterpret_cast<ValueType*>(this->m_bytes)); }
+
+	[[nodiscard]]
+	const ValueType& value() const noexcept
+	{ return *std::launder(reinterpret_cast<const ValueType*>(this->m_bytes)); }
+
+	[[nodiscard]]
+	ErrorType& error() noexcept
+	{ return *std::launder(reinterpret_cast<ErrorType*>(this->m_bytes)); }
+
+	[[nodiscard]]
+	const ErrorType& error() const noexcept
+	{ return *std::launder(reinterpret_cast<const ErrorType*>(this->m_bytes)); }
+
+	template<typename T>
+	void emplace_value(T&& value)
+	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
+	{
+		result_helpers::reconstruct(
+			reinterpret_cast<ValueType*>(this->m_bytes),
+			std::addressof(this->error()),
+			std::forward<T>(value));
+		this->m_has_value = true;
+	}
+
+	template<typename T>
+	void emplace_error(T&& error)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+	{
+		result_helpers::reconstruct(
+			reinterpret_cast<ErrorType*>(this->m_bytes),
+			std::addressof(this->value()),
+			std::forward<T>(error));
+		this->m_has_value = false;
+	}
+
+	alignas(ValueType) alignas(ErrorType) std::byte m_bytes[
+		sizeof(ValueType) > sizeof(ErrorType)
+			? sizeof(ValueType)
+			: sizeof(ErrorType)];
+	bool m_has_value;
+};
+
+template<typename ValueType, typename ErrorType>
+struct select_storage
+	: std::type_identity<tagged_storage<ValueType, ErrorType>>
+{};
+
+template<typename ValueType, typename ErrorType>
+	requires u::has_niche_v<ValueType>
+		&& is_niche_filler_v<ErrorType>
+struct select_storage<ValueType, ErrorType>
+	: std::type_identity<value_niche_storage<ValueType, ErrorType>>
+{};
+
+template<typename ValueType, typename ErrorType>
+	requires is_niche_filler_v<ValueType>
+		&& u::has_niche_v<ErrorType>
+		&& (!u::has_niche_v<ValueType>)
+struct select_storage<ValueType, ErrorType>
+	: std::type_identity<error_niche_storage<ValueType, ErrorType>>
+{};
+
+template<typename ValueType, typename ErrorType>
+	requires u::is_trivially_relocatable_v<ValueType>
+		&& u::is_trivially_relocatable_v<ErrorType>
+		&& (!std::is_trivially_copyable_v<ValueType>
+			|| !std::is_trivially_copyable_v<ErrorType>)
+struct select_storage<ValueType, ErrorType>
+	: std::type_identity<relocatable_storage<ValueType, ErrorType>>
+{};
+
+template<typename ValueType, typename ErrorType>
+using storage_t = typename select_storage<ValueType, ErrorType>::type;
+
 }  // namespace detail::result_helpers
 
+// Results over trivially relocatable payloads are passed in registers
+// under Clang; for every other payload the attribute is dropped.
 template<typename ValueType, typename ErrorType>
-class result
+class U_TRIVIAL_ABI result
 {
 	static_assert(u::is_valid_result_v<ValueType>);
 	static_assert(u::is_valid_error_v<ErrorType>);
@@ -309,262 +874,1186 @@ public:
 		T<U, ValueType>::value
 		|| T<V, ErrorType>::value;
 
+	using value_type = ValueType;
+	using error_type = ErrorType;
+
+private:
+	template<typename, typename>
+	friend class result;
+
+	template<typename T, typename U>
+	static constexpr bool m_is_constructible_from_result_v =
+		conjunction_with_v<std::is_constructible, T, U>
+		&& !(std::is_constructible_v<ValueType, result<T, U>>
+			|| std::is_constructible_v<ValueType, result<T, U>&>
+			|| std::is_constructible_v<ValueType, const result<T, U>>
+			|| std::is_constructible_v<ValueType, const result<T, U>&>
+			|| std::is_constructible_v<result<T, U>, ValueType>
+			|| std::is_constructible_v<result<T, U>&, ValueType>
+			|| std::is_constructible_v<const result<T, U>, ValueType>
+			|| std::is_constructible_v<const result<T, U>, ValueType>
+			|| std::is_constructible_v<error<ErrorType>, result<T, U>>
+			|| std::is_constructible_v<error<ErrorType>, result<T, U>&>
+			|| std::is_constructible_v<error<ErrorType>, const result<T, U>>
+			|| std::is_constructible_v<error<ErrorType>, const result<T, U>&>);
+
+	template<typename T, typename U>
+	static constexpr bool m_is_explicitly_constructible_from_result_v =
+		disjunction_with_before_v<std::is_convertible, T, U>;
+
+	template<typename T, typename U>
+	static constexpr bool m_is_nothrow_constructible_from_result_v = 
+		conjunction_with_v<std::is_nothrow_constructible, T, U>;
+
+	template<typename T, typename U, typename... Ts>
+	static constexpr bool m_is_constructible_with_il_v =
+		std::is_constructible_v<T, std::initializer_list<U>&, Ts...>;
+
+	template<typename T, typename U, typename... Ts>
+	static constexpr bool m_is_nothrow_constructible_with_il_v =
+		std::is_nothrow_constructible_v<T, std::initializer_list<U>&, Ts...>;
+
+	static constexpr bool m_is_copy_assignable_v =
+		conjunction_v<std::is_copy_assignable>
+		&& conjunction_v<std::is_copy_constructible>
+		&& disjunction_v<std::is_nothrow_move_constructible>;
+
+	static constexpr bool m_is_nothrow_copy_assignable_v =
+		conjunction_v<std::is_nothrow_copy_constructible>
+		&& conjunction_v<std::is_nothrow_copy_assignable>;
+
+	static constexpr bool m_is_trivially_copy_assignable_v =
+		conjunction_v<std::is_trivially_copy_constructible>
+		&& conjunction_v<std::is_trivially_copy_assignable>
+		&& conjunction_v<std::is_trivially_destructible>;
+
+	static constexpr bool m_is_move_assignable_v =
+		conjunction_v<std::is_move_assignable>
+		&& conjunction_v<std::is_move_constructible>
+		&& disjunction_v<std::is_nothrow_move_constructible>;
+
+	static constexpr bool m_is_nothrow_move_assignable_v =
+		conjunction_v<std::is_nothrow_move_constructible>
+		&& conjunction_v<std::is_nothrow_move_assignable>;
+
+	static constexpr bool m_is_trivially_move_assignable_v =
+		conjunction_v<std::is_trivially_move_constructible>
+		&& conjunction_v<std::is_trivially_move_assignable>
+		&& conjunction_v<std::is_trivially_destructible>;
+
+	template<typename T>
+	static constexpr bool m_is_assignable_with_error_v =
+		std::is_constructible_v<ErrorType, const T&>
+		&& std::is_assignable_v<ErrorType&, const T&>
+		&& (std::is_nothrow_constructible_v<ErrorType, const T&>
+			|| disjunction_v<std::is_nothrow_move_constructible>);
+
+	template<typename F, typename T>
+	using m_function_result_t =
+		std::remove_cvref_t<
+			std::invoke_result_t<F&&, T&&>>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_value_function_result_v =
+		u::is_result_v<T>
+		&& std::is_same_v<typename T::error_type, ErrorType>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_error_function_result_v =
+		u::is_result_v<T>
+		&& std::is_same_v<typename T::value_type, ValueType>;
+
+public:
+	constexpr result()
+	noexcept(std::is_nothrow_default_constructible_v<ValueType>)
+		requires std::is_default_constructible_v<ValueType>
+		: m_storage{std::in_place}
+	{}
+
+	constexpr result(const result&) = default;
+	constexpr result(result&&) = default;
+
+	template<typename T, typename U>
+		requires m_is_constructible_from_result_v<T, U>
+	constexpr explicit(m_is_explicitly_constructible_from_result_v<T, U>)
+	result(const result<T, U>& other)
+	noexcept(m_is_nothrow_constructible_from_result_v<T, U>)
+		: m_storage{detail::result_helpers::from_storage, other.m_storage}
+	{}
+
+	template<typename T, typename U>
+		requires m_is_constructible_from_result_v<T, U>
+	constexpr explicit(m_is_explicitly_constructible_from_result_v<T, U>)
+	result(result<T, U>&& other)
+	noexcept(m_is_nothrow_constructible_from_result_v<T, U>)
+		: m_storage{
+			detail::result_helpers::from_storage,
+			std::move(other.m_storage)}
+	{}
+
+	template<typename T = ValueType>
+		requires (!std::is_same_v<std::remove_cvref_t<T>, std::in_place_t>)
+			&& (!std::is_same_v<std::remove_cvref_t<T>, result>)
+			&& std::is_constructible_v<ValueType, T>
+			&& (!is_error_v<std::remove_cvref_t<T>>)
+	constexpr explicit(!std::is_convertible_v<T, ValueType>)
+	result(T&& value)
+	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
+		: m_storage{std::in_place, std::forward<T>(value)}
+	{}
+
+	template<typename T = ErrorType>
+		requires std::is_constructible_v<ErrorType, const T&>
+	constexpr explicit(!std::is_convertible_v<const T&, ErrorType>)
+	result(const error<T>& error U_DETAIL_ERROR_SITE)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, const T&>)
+		: m_storage{u::error_tag, error.get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
+
+	template<typename T = ErrorType>
+		requires std::is_constructible_v<ErrorType, T>
+	constexpr explicit(!std::is_convertible_v<T, ErrorType>)
+	result(error<T>&& error U_DETAIL_ERROR_SITE)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+		: m_storage{u::error_tag, std::move(error).get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
+
+	constexpr explicit result(std::in_place_t) noexcept
+		: m_storage{std::in_place}
+	{}
+
+	template<typename... Ts>
+		requires std::is_constructible_v<ValueType, Ts...>
+	constexpr explicit result(std::in_place_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
+		: m_storage{std::in_place, std::forward<Ts>(args)...}
+	{}
+
+	template<typename T, typename... Ts>
+		requires m_is_constructible_with_il_v<ValueType, T, Ts...>
+	constexpr explicit result(std::in_place_t,
+				  std::initializer_list<T> list,
+				  Ts&&...		   args)
+	noexcept(m_is_nothrow_constructible_with_il_v<ValueType, T, Ts...>)
+		: m_storage{std::in_place, list, std::forward<Ts>(args)...}
+	{}
+
+	template<typename... Ts>
+		requires std::is_constructible_v<ErrorType, Ts...>
+	constexpr explicit result(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_storage{u::error_tag, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
+
+	template<typename T, typename... Ts>
+		requires m_is_constructible_with_il_v<ErrorType, T, Ts...>
+	constexpr explicit result(
+		u::error_tag_t,
+		std::initializer_list<T> list,
+		Ts&&...			 args)
+	noexcept(m_is_nothrow_constructible_with_il_v<ErrorType, T, Ts...>)
+		: m_storage{u::error_tag, list, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
+
+	constexpr ~result() = default;
+
+	// Each assignment is trivial exactly when it is trivial for both
+	// alternatives, user-provided when both merely support it, and absent
+	// otherwise.
+	constexpr result& operator=(const result&)
+		requires m_is_trivially_copy_assignable_v
+	= default;
+
+	constexpr result& operator=(const result& other)
+	noexcept(m_is_nothrow_copy_assignable_v)
+		requires m_is_copy_assignable_v
+			&& (!m_is_trivially_copy_assignable_v)
+	{
+		if (other.has_value())
+			this->m_assign_value(other.m_storage.value());
+		else this->m_assign_error(other.m_storage.error());
+		return *this;
+	}
+
+	constexpr result& operator=(result&&)
+		requires m_is_trivially_move_assignable_v
+	= default;
+
+	constexpr result& operator=(result&& other)
+	noexcept(m_is_nothrow_move_assignable_v)
+		requires m_is_move_assignable_v
+			&& (!m_is_trivially_move_assignable_v)
+	{
+		if (other.has_value())
+			this->m_assign_value(std::move(other.m_storage.value()));
+		else this->m_assign_error(std::move(other.m_storage.error()));
+		return *this;
+	}
+
+	template<typename T = ValueType>
+		requires (!std::is_same_v<std::remove_cvref_t<T>, result>)
+			&& (!is_error_v<std::remove_cvref_t<T>>)
+			&& std::is_constructible_v<ValueType, T>
+			&& std::is_assignable_v<ValueType&, T>
+			&& (std::is_nothrow_constructible_v<ValueType, T>
+				|| disjunction_v<std::is_nothrow_move_constructible>)
+	constexpr result& operator=(T&& value)
+	{
+		this->m_assign_value(std::forward<T>(value));
+		return *this;
+	}
+
+	template<typename T>
+		requires m_is_assignable_with_error_v<T>
+	constexpr result& operator=(const error<T>& error)
+	{
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(error.get());
+		return *this;
+	}
+
+	template<typename T>
+		requires m_is_assignable_with_error_v<T>
+	constexpr result& operator=(error<T>&& error)
+	{
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(std::move(error).get());
+		return *this;
+	}
+
+	//
+	// Observers
+	//
+
+	constexpr explicit operator bool() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr ValueType* operator->()
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return std::addressof(this->m_storage.value());
+	}
+
+	[[nodiscard]]
+	constexpr const ValueType* operator->() const
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return std::addressof(this->m_storage.value());
+	}
+
+	[[nodiscard]]
+	constexpr ValueType& operator*() &
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	[[nodiscard]]
+	constexpr const ValueType& operator*() const&
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	[[nodiscard]]
+	constexpr ValueType&& operator*() &&
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
+		return std::move(this->m_storage.value());
+	}
+
+	[[nodiscard]]
+	constexpr const ValueType&& operator*() const&&
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
+		return std::move(this->m_storage.value());
+	}
+
+	// The value, with the access checked as `Policy` says, one of the
+	// `U_ACCESS_*` macros. It defaults to `U_RESULT_VALUE_ACCESS`, and is
+	// given for a single access where another check is wanted:
+	//
+	//	if (parsed.has_value())
+	//		for (const auto& item : parsed.value<U_ACCESS_ASSUME>())
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr ValueType& value() &
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr const ValueType& value() const&
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr ValueType&& value() &&
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
+		return std::move(this->m_storage.value());
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr const ValueType&& value() const&&
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
+		return std::move(this->m_storage.value());
+	}
+
+	[[nodiscard]]
+	constexpr ErrorType& error() & noexcept
+	{ return this->m_storage.error(); }
+
+	[[nodiscard]]
+	constexpr ErrorType const& error() const& noexcept
+	{ return this->m_storage.error(); }
+
+	[[nodiscard]]
+	constexpr ErrorType&& error() && noexcept
+	{ return std::move(this->m_storage.error()); }
+
+	[[nodiscard]]
+	constexpr const ErrorType&& error() const&& noexcept
+	{ return std::move(this->m_storage.error()); }
+
+	template<typename T = ValueType>
+	[[nodiscard]]
+	constexpr ValueType value_or(T&& other_value) const&
+	noexcept(std::is_nothrow_copy_constructible_v<ValueType>
+		&& std::is_nothrow_convertible_v<T, ValueType>)
+		requires std::is_convertible_v<T, ValueType>
+			&& std::is_copy_constructible_v<ValueType>
+	{
+		if (this->has_value())
+			return this->m_storage.value();
+		return static_cast<ValueType>(std::forward<T>(other_value));
+	}
+
+	template<typename T = ValueType>
+	[[nodiscard]]
+	constexpr ValueType value_or(T&& value) &&
+	noexcept(std::is_nothrow_move_constructible_v<ValueType>
+		&& std::is_nothrow_convertible_v<T, ValueType>)
+		requires std::is_convertible_v<T, ValueType>
+			&& std::is_move_constructible_v<ValueType>
+	{ 
+		if (this->has_value())
+			return std::move(this->m_storage.value());
+		return static_cast<ValueType>(std::forward<T>(value));
+	} 
+
+	template<typename T = ErrorType>
+	[[nodiscard]]
+	constexpr ErrorType error_or(ErrorType&& error) const&
+		requires std::is_convertible_v<T, ErrorType>
+			&& std::is_copy_constructible_v<T>
+	{
+		if (this->has_value())
+			return std::forward<T>(error);
+		return this->m_storage.error();
+	}
+
+	template<typename T = ErrorType>
+	[[nodiscard]]
+	constexpr ErrorType error_or(T&& error) &&
+		requires std::is_convertible_v<T, ErrorType>
+			&& std::is_constructible_v<ErrorType, T>
+	{
+		if (this->has_value())
+			return std::forward<T>(error);
+		return std::move(this->m_storage.error());
+	}
+
+	//
+	// Monadic Operations
+	//
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) &
+		requires std::is_constructible_v<ErrorType, ErrorType&>
+	{
+		using result_t = result::m_function_result_t<F, ValueType&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn), this->m_storage.value());
+		return result_t{u::error_tag, this->m_storage.error()};
+	}
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) const&
+		requires std::is_constructible_v<ErrorType, const ErrorType&>
+	{
+		using result_t = result::m_function_result_t<F, const ValueType&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn), this->m_storage.value());
+		return result_t{u::error_tag, this->m_storage.error()};
+	}
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) &&
+		requires std::is_constructible_v<ErrorType, ErrorType>
+	{
+		using result_t = result::m_function_result_t<F, ValueType&&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(
+				std::forward<F>(fn),
+				std::move(this->m_storage.value()));
+		return result_t{u::error_tag, std::move(this->m_storage.error())};
+	}
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) const&&
+		requires std::is_constructible_v<ErrorType, const ErrorType>
+	{
+		using result_t = result::m_function_result_t<
+			F, const ValueType&&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(
+				std::forward<F>(fn),
+				std::move(this->m_storage.value()));
+		return result_t{u::error_tag, std::move(this->m_storage.error())};
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) &
+		requires std::is_constructible_v<ValueType, ValueType&>
+	{
+		using result_t = result::m_function_result_t<F, ErrorType&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{std::in_place, this->m_storage.value()};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) const&
+		requires std::is_constructible_v<ValueType, const ValueType&>
+	{
+		using result_t = result::m_function_result_t<F, const ErrorType&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{std::in_place, this->m_storage.value()};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) &&
+		requires std::is_constructible_v<ValueType, ValueType&&>
+	{
+		using result_t = result::m_function_result_t<F, ErrorType&&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{
+				std::in_place,
+				std::move(this->m_storage.value())};
+		return std::invoke(
+			std::forward<F>(fn),
+			std::move(this->m_storage.error()));
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) const&&
+		requires std::is_constructible_v<ValueType, const ValueType&&>
+	{
+		using result_t = result::m_function_result_t<
+			F,
+			const ErrorType&&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{
+				std::in_place,
+				std::move(this->m_storage.value())};
+		return std::invoke(
+			std::forward<F>(fn),
+			std::move(this->m_storage.error()));
+	}
+
+private:
+	detail::result_helpers::storage_t<ValueType, ErrorType> m_storage;
+
+	template<typename T>
+	constexpr void m_assign_value(T&& value)
+	{
+		if (this->has_value())
+			this->m_storage.value() = std::forward<T>(value);
+		else this->m_storage.emplace_value(std::forward<T>(value));
+	}
+
+	template<typename T>
+	constexpr void m_assign_error(T&& error)
+	{
+		if (this->has_value())
+			this->m_storage.emplace_error(std::forward<T>(error));
+		else this->m_storage.error() = std::forward<T>(error);
+	}
+};
+
+// A result that refers to an existing object on success. The reference is
+// stored as a pointer that is never null, so null is a niche and the result
+// is pointer-sized when the error is empty. Assigning a new object rebinds
+// the reference instead of assigning through it.
+template<typename ValueType, typename ErrorType>
+class U_TRIVIAL_ABI result<ValueType&, ErrorType>
+{
+	static_assert(u::is_valid_result_v<ValueType&>);
+	static_assert(u::is_valid_error_v<ErrorType>);
+
+	using reference = detail::result_helpers::reference<ValueType>;
+
+public:
+	using value_type = ValueType&;
+	using error_type = ErrorType;
+
 private:
-	using value_type = ValueType;
-		
+	template<typename, typename>
+	friend class result;
+
+	template<typename T>
+	static constexpr bool m_is_bindable_v =
+		std::is_convertible_v<T*, ValueType*>;
+
+	template<typename T, typename U, typename Argument>
+	static constexpr bool m_is_constructible_from_result_v =
+		std::is_lvalue_reference_v<T>
+		&& m_is_bindable_v<std::remove_reference_t<T>>
+		&& std::is_constructible_v<ErrorType, Argument>;
+
+	template<typename T, typename... Ts>
+	static constexpr bool m_is_constructible_with_il_v =
+		std::is_constructible_v<ErrorType, std::initializer_list<T>&, Ts...>;
+
+	template<typename T, typename... Ts>
+	static constexpr bool m_is_nothrow_constructible_with_il_v =
+		std::is_nothrow_constructible_v<
+			ErrorType,
+			std::initializer_list<T>&,
+			Ts...>;
+
+	static constexpr bool m_is_trivially_copy_assignable_v =
+		std::is_trivially_copy_constructible_v<ErrorType>
+		&& std::is_trivially_copy_assignable_v<ErrorType>
+		&& std::is_trivially_destructible_v<ErrorType>;
+
+	static constexpr bool m_is_trivially_move_assignable_v =
+		std::is_trivially_move_constructible_v<ErrorType>
+		&& std::is_trivially_move_assignable_v<ErrorType>
+		&& std::is_trivially_destructible_v<ErrorType>;
+
+	template<typename T>
+	static constexpr bool m_is_assignable_with_error_v =
+		std::is_constructible_v<ErrorType, T>
+		&& std::is_assignable_v<ErrorType&, T>;
+
+	template<typename F, typename T>
+	using m_function_result_t =
+		std::remove_cvref_t<
+			std::invoke_result_t<F&&, T&&>>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_value_function_result_v =
+		u::is_result_v<T>
+		&& std::is_same_v<typename T::error_type, ErrorType>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_error_function_result_v =
+		u::is_result_v<T>
+		&& std::is_same_v<typename T::value_type, ValueType&>;
+
+public:
+	constexpr result(const result&) = default;
+	constexpr result(result&&) = default;
+
+	template<typename T, typename U>
+		requires m_is_constructible_from_result_v<T, U, const U&>
+	constexpr explicit(!std::is_convertible_v<const U&, ErrorType>)
+	result(const result<T, U>& other)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, const U&>)
+		: m_storage{detail::result_helpers::from_storage, other.m_storage}
+	{}
+
 	template<typename T, typename U>
+		requires m_is_constructible_from_result_v<T, U, U>
+	constexpr explicit(!std::is_convertible_v<U, ErrorType>)
+	result(result<T, U>&& other)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, U>)
+		: m_storage{
+			detail::result_helpers::from_storage,
+			std::move(other.m_storage)}
+	{}
+
+	template<typename T>
+		requires m_is_bindable_v<T>
+	constexpr result(T& value) noexcept
+		: m_storage{std::in_place, std::addressof(value)}
+	{}
+
+	template<typename T>
+		requires (!std::is_lvalue_reference_v<T>)
+			&& m_is_bindable_v<T>
+	result(T&& value) = delete;
+
+	template<typename T = ErrorType>
+		requires std::is_constructible_v<ErrorType, const T&>
+	constexpr explicit(!std::is_convertible_v<const T&, ErrorType>)
+	result(const error<T>& error U_DETAIL_ERROR_SITE)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, const T&>)
+		: m_storage{u::error_tag, error.get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
+
+	template<typename T = ErrorType>
+		requires std::is_constructible_v<ErrorType, T>
+	constexpr explicit(!std::is_convertible_v<T, ErrorType>)
+	result(error<T>&& error U_DETAIL_ERROR_SITE)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
+		: m_storage{u::error_tag, std::move(error).get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
+
+	template<typename T>
+		requires m_is_bindable_v<T>
+	constexpr explicit result(std::in_place_t, T& value) noexcept
+		: m_storage{std::in_place, std::addressof(value)}
+	{}
+
+	template<typename... Ts>
+		requires std::is_constructible_v<ErrorType, Ts...>
+	constexpr explicit result(u::error_tag_t, Ts&&... args)
+	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
+		: m_storage{u::error_tag, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
+
+	template<typename T, typename... Ts>
+		requires m_is_constructible_with_il_v<T, Ts...>
+	constexpr explicit result(
+		u::error_tag_t,
+		std::initializer_list<T> list,
+		Ts&&...			 args)
+	noexcept(m_is_nothrow_constructible_with_il_v<T, Ts...>)
+		: m_storage{u::error_tag, list, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
+
+	constexpr ~result() = default;
+
+	constexpr result& operator=(const result&)
+		requires m_is_trivially_copy_assignable_v
+	= default;
+
+	constexpr result& operator=(const result& other)
+	noexcept(std::is_nothrow_copy_constructible_v<ErrorType>
+		&& std::is_nothrow_copy_assignable_v<ErrorType>)
+		requires std::is_copy_constructible_v<ErrorType>
+			&& std::is_copy_assignable_v<ErrorType>
+			&& (!m_is_trivially_copy_assignable_v)
+	{
+		if (other.has_value())
+			this->m_assign_value(other.m_storage.value());
+		else this->m_assign_error(other.m_storage.error());
+		return *this;
+	}
+
+	constexpr result& operator=(result&&)
+		requires m_is_trivially_move_assignable_v
+	= default;
+
+	constexpr result& operator=(result&& other)
+	noexcept(std::is_nothrow_move_constructible_v<ErrorType>
+		&& std::is_nothrow_move_assignable_v<ErrorType>)
+		requires std::is_move_constructible_v<ErrorType>
+			&& std::is_move_assignable_v<ErrorType>
+			&& (!m_is_trivially_move_assignable_v)
+	{
+		if (other.has_value())
+			this->m_assign_value(other.m_storage.value());
+		else this->m_assign_error(std::move(other.m_storage.error()));
+		return *this;
+	}
+
+	template<typename T>
+		requires m_is_bindable_v<T>
+	constexpr result& operator=(T& value) noexcept
+	{
+		this->m_assign_value(reference{std::addressof(value)});
+		return *this;
+	}
+
+	template<typename T>
+		requires (!std::is_lvalue_reference_v<T>)
+			&& m_is_bindable_v<T>
+	result& operator=(T&& value) = delete;
+
+	template<typename T>
+		requires m_is_assignable_with_error_v<const T&>
+	constexpr result& operator=(const error<T>& error)
+	{
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(error.get());
+		return *this;
+	}
+
+	template<typename T>
+		requires m_is_assignable_with_error_v<T>
+	constexpr result& operator=(error<T>&& error)
+	{
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(std::move(error).get());
+		return *this;
+	}
+
+	template<typename T>
+		requires m_is_bindable_v<T>
+	constexpr ValueType& emplace(T& value) noexcept
+	{
+		this->m_assign_value(reference{std::addressof(value)});
+		return value;
+	}
+
+	//
+	// Observers
+	//
+
+	constexpr explicit operator bool() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr ValueType* operator->() const
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value().m_pointer;
+	}
+
+	[[nodiscard]]
+	constexpr ValueType& operator*() const
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return *this->m_storage.value().m_pointer;
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr ValueType& value() const&
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return *this->m_storage.value().m_pointer;
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr ValueType& value() &&
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
+		return *this->m_storage.value().m_pointer;
+	}
+
+	[[nodiscard]]
+	constexpr ErrorType& error() & noexcept
+	{ return this->m_storage.error(); }
+
+	[[nodiscard]]
+	constexpr const ErrorType& error() const& noexcept
+	{ return this->m_storage.error(); }
+
+	[[nodiscard]]
+	constexpr ErrorType&& error() && noexcept
+	{ return std::move(this->m_storage.error()); }
+
+	[[nodiscard]]
+	constexpr const ErrorType&& error() const&& noexcept
+	{ return std::move(this->m_storage.error()); }
+
+	// Returns a reference rather than a copy, so `other` has to outlive its
+	// use just like the referenced value.
+	template<typename T>
+		requires m_is_bindable_v<T>
+	[[nodiscard]]
+	constexpr ValueType& value_or(T& other) const noexcept
+	{
+		if (this->has_value())
+			return *this->m_storage.value().m_pointer;
+		return other;
+	}
+
+	template<typename T = ErrorType>
+	[[nodiscard]]
+	constexpr ErrorType error_or(T&& error) const&
+		requires std::is_convertible_v<T, ErrorType>
+			&& std::is_copy_constructible_v<ErrorType>
+	{
+		if (this->has_value())
+			return std::forward<T>(error);
+		return this->m_storage.error();
+	}
+
+	template<typename T = ErrorType>
+	[[nodiscard]]
+	constexpr ErrorType error_or(T&& error) &&
+		requires std::is_convertible_v<T, ErrorType>
+			&& std::is_move_constructible_v<ErrorType>
+	{
+		if (this->has_value())
+			return std::forward<T>(error);
+		return std::move(this->m_storage.error());
+	}
+
+	//
+	// Monadic Operations
+	//
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) const&
+		requires std::is_constructible_v<ErrorType, const ErrorType&>
+	{
+		using result_t = result::m_function_result_t<F, ValueType&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(
+				std::forward<F>(fn),
+				*this->m_storage.value().m_pointer);
+		return result_t{u::error_tag, this->m_storage.error()};
+	}
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) &&
+		requires std::is_constructible_v<ErrorType, ErrorType>
+	{
+		using result_t = result::m_function_result_t<F, ValueType&>;
+		static_assert(result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(
+				std::forward<F>(fn),
+				*this->m_storage.value().m_pointer);
+		return result_t{
+			u::error_tag,
+			std::move(this->m_storage.error())};
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) &
+	{
+		using result_t = result::m_function_result_t<F, ErrorType&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{*this->m_storage.value().m_pointer};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) const&
+	{
+		using result_t = result::m_function_result_t<F, const ErrorType&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{*this->m_storage.value().m_pointer};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) &&
+	{
+		using result_t = result::m_function_result_t<F, ErrorType&&>;
+		static_assert(result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{*this->m_storage.value().m_pointer};
+		return std::invoke(
+			std::forward<F>(fn),
+			std::move(this->m_storage.error()));
+	}
+
+private:
+	detail::result_helpers::storage_t<reference, ErrorType> m_storage;
+
+	constexpr void m_assign_value(reference value) noexcept
+	{
+		if (this->has_value())
+			this->m_storage.value() = value;
+		else this->m_storage.emplace_value(value);
+	}
+
+	template<typename T>
+	constexpr void m_assign_error(T&& error)
+	{
+		if (this->has_value())
+			this->m_storage.emplace_error(std::forward<T>(error));
+		else this->m_storage.error() = std::forward<T>(error);
+	}
+};
+
+// A result that carries nothing on success. The value is stored as an empty
+// `unit`, so the result is as large as `ErrorType` plus a flag, or as large
+// as `ErrorType` alone when the error has a niche.
+template<typename ErrorType>
+class U_TRIVIAL_ABI result<void, ErrorType>
+{
+	static_assert(u::is_valid_error_v<ErrorType>);
+
+	using unit = detail::result_helpers::unit;
+
+public:
+	using value_type = void;
+	using error_type = ErrorType;
+
+private:
+	template<typename, typename>
+	friend class result;
+
+	template<typename T, typename U, typename Argument>
 	static constexpr bool m_is_constructible_from_result_v =
-		conjunction_with_v<std::is_constructible, T, U>
-		&& !(std::is_constructible_v<ValueType, result<T, U>>
-			|| std::is_constructible_v<ValueType, result<T, U>&>
-			|| std::is_constructible_v<ValueType, const result<T, U>>
-			|| std::is_constructible_v<ValueType, const result<T, U>&>
-			|| std::is_constructible_v<result<T, U>, ValueType>
-			|| std::is_constructible_v<result<T, U>&, ValueType>
-			|| std::is_constructible_v<const result<T, U>, ValueType>
-			|| std::is_constructible_v<const result<T, U>, ValueType>
-			|| std::is_constructible_v<error<ErrorType>, result<T, U>>
+		std::is_void_v<T>
+		&& std::is_constructible_v<ErrorType, Argument>
+		&& !(std::is_constructible_v<error<ErrorType>, result<T, U>>
 			|| std::is_constructible_v<error<ErrorType>, result<T, U>&>
 			|| std::is_constructible_v<error<ErrorType>, const result<T, U>>
 			|| std::is_constructible_v<error<ErrorType>, const result<T, U>&>);
 
-	template<typename T, typename U>
-	static constexpr bool m_is_explicitly_constructible_from_result_v =
-		disjunction_with_before_v<std::is_convertible, T, U>;
-
-	template<typename T, typename U>
-	static constexpr bool m_is_nothrow_constructible_from_result_v = 
-		conjunction_with_v<std::is_nothrow_constructible, T, U>;
-
-	template<typename T, typename U, typename... Ts>
+	template<typename T, typename... Ts>
 	static constexpr bool m_is_constructible_with_il_v =
-		std::is_constructible_v<T, std::initializer_list<U>&, Ts...>;
+		std::is_constructible_v<ErrorType, std::initializer_list<T>&, Ts...>;
 
-	template<typename T, typename U, typename... Ts>
+	template<typename T, typename... Ts>
 	static constexpr bool m_is_nothrow_constructible_with_il_v =
-		std::is_nothrow_constructible_v<T, std::initializer_list<U>&, Ts...>;
+		std::is_nothrow_constructible_v<
+			ErrorType,
+			std::initializer_list<T>&,
+			Ts...>;
 
-	static constexpr bool m_is_copy_or_move_assignable_v =
-		conjunction_v<std::is_copy_assignable>
-		&& conjunction_v<std::is_copy_constructible>
-		&& disjunction_v<std::is_nothrow_move_constructible>;
+	static constexpr bool m_is_trivially_copy_assignable_v =
+		std::is_trivially_copy_constructible_v<ErrorType>
+		&& std::is_trivially_copy_assignable_v<ErrorType>
+		&& std::is_trivially_destructible_v<ErrorType>;
 
-	static constexpr bool m_is_nothrow_copy_or_move_assignable_v =
-		conjunction_v<std::is_nothrow_copy_constructible>
-		&& conjunction_v<std::is_copy_assignable>;
+	static constexpr bool m_is_trivially_move_assignable_v =
+		std::is_trivially_move_constructible_v<ErrorType>
+		&& std::is_trivially_move_assignable_v<ErrorType>
+		&& std::is_trivially_destructible_v<ErrorType>;
 
 	template<typename T>
 	static constexpr bool m_is_assignable_with_error_v =
-		std::is_constructible_v<ErrorType, const T&>
-		&& std::is_assignable_v<ErrorType&, const T&>
-		&& (std::is_nothrow_constructible_v<ErrorType, const T&>
-			|| disjunction_v<std::is_nothrow_move_constructible>);
+		std::is_constructible_v<ErrorType, T>
+		&& std::is_assignable_v<ErrorType&, T>;
 
-	template<typename F, typename T>
+	template<typename F, typename... Ts>
 	using m_function_result_t =
 		std::remove_cvref_t<
-			std::invoke_result_t<F&&, T&&>>;
+			std::invoke_result_t<F&&, Ts&&...>>;
 
 	template<typename T>
-	static constexpr bool m_is_valid_error_function_result_v =
-		u::is_error_v<T>
+	static constexpr bool m_is_valid_value_function_result_v =
+		u::is_result_v<T>
 		&& std::is_same_v<typename T::error_type, ErrorType>;
 
 	template<typename T>
-	static constexpr bool m_is_valid_value_function_result_v =
+	static constexpr bool m_is_valid_error_function_result_v =
 		u::is_result_v<T>
-		&& std::is_same_v<typename T::value_type, ValueType>;
+		&& std::is_void_v<typename T::value_type>;
 
 public:
-	constexpr result()
-	noexcept(std::is_nothrow_default_constructible_v<ValueType>)
-		requires std::is_default_constructible_v<ValueType>
-		: m_value{}
+	constexpr result() noexcept
+		: m_storage{std::in_place}
 	{}
 
-	result(const result&) = default;
-
-	constexpr result(const result& other)
-	noexcept(conjunction_v<std::is_nothrow_copy_constructible>)
-		requires conjunction_v<std::is_copy_constructible>
-			&& (!disjunction_v<std::is_trivially_copy_constructible>)
-		: m_has_value{other.m_has_value}
-	{
-		if (this->m_has_value)
-			std::construct_at(
-				std::addressof(this->m_value),
-				other.m_value);
-		else std::construct_at(
-			std::addressof(this->m_error),
-			other.m_error);
-	}
-
-	result(const result&&) = default;
-
-	constexpr result(result&& other)
-	noexcept(conjunction_v<std::is_nothrow_move_constructible>)
-		requires conjunction_v<std::is_move_constructible>
-			&& (!disjunction_v<std::is_trivially_move_constructible>)
-		: m_has_value{other.m_has_value}
-	{
-		if (this->m_has_value)
-			std::construct_at(
-				std::addressof(this->m_value),
-				std::move(other.m_value));
-		else std::construct_at(
-			std::addressof(this->m_error),
-			std::move(other.m_error));
-	}
+	constexpr result(const result&) = default;
+	constexpr result(result&&) = default;
 
 	template<typename T, typename U>
-		requires m_is_constructible_from_result_v<T, U>
-	constexpr explicit(m_is_explicitly_constructible_from_result_v<T, U>)
+		requires m_is_constructible_from_result_v<T, U, const U&>
+	constexpr explicit(!std::is_convertible_v<const U&, ErrorType>)
 	result(const result<T, U>& other)
-	noexcept(m_is_nothrow_constructible_from_result_v<T, U>)
-		: m_has_value{other.m_has_value}
-	{
-		if (this->m_has_value)
-			std::construct_at(
-				std::addressof(this->m_value),
-				other.m_value);
-		else std::construct_at(
-			std::addressof(this->m_error),
-			other.m_error);
-	}
+	noexcept(std::is_nothrow_constructible_v<ErrorType, const U&>)
+		: m_storage{detail::result_helpers::from_storage, other.m_storage}
+	{}
 
 	template<typename T, typename U>
-		requires m_is_constructible_from_result_v<T, U>
-	constexpr explicit(m_is_explicitly_constructible_from_result_v<T, U>)
+		requires m_is_constructible_from_result_v<T, U, U>
+	constexpr explicit(!std::is_convertible_v<U, ErrorType>)
 	result(result<T, U>&& other)
-	noexcept(m_is_nothrow_constructible_from_result_v<T, U>)
-		: m_has_value{other.m_has_value}
-	{
-		if (this->m_has_value)
-			std::construct_at(
-				std::addressof(this->m_value),
-				std::move(other.m_value));
-		else std::construct_at(
-			std::addressof(this->m_error),
-			std::move(other.m_error));
-	}
-
-	template<typename T = ValueType>
-		requires (!std::is_same_v<std::remove_cvref_t<T>, std::in_place_t>)
-			&& (!std::is_same_v<std::remove_cvref_t<T>, result>)
-			&& std::is_constructible_v<ValueType, T>
-			&& (!is_error_v<std::remove_cvref_t<T>>)
-	constexpr explicit(!std::is_convertible_v<T, ValueType>)
-	result(T&& value)
-	noexcept(std::is_nothrow_constructible_v<ValueType, T>)
-		: m_value{std::forward<T>(value)}
+	noexcept(std::is_nothrow_constructible_v<ErrorType, U>)
+		: m_storage{
+			detail::result_helpers::from_storage,
+			std::move(other.m_storage)}
 	{}
 
 	template<typename T = ErrorType>
 		requires std::is_constructible_v<ErrorType, const T&>
 	constexpr explicit(!std::is_convertible_v<const T&, ErrorType>)
-	result(const error<T>& error)
+	result(const error<T>& error U_DETAIL_ERROR_SITE)
 	noexcept(std::is_nothrow_constructible_v<ErrorType, const T&>)
-		: m_error{error.error()},
-		  m_has_value{false}
-	{}
+		: m_storage{u::error_tag, error.get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
 
 	template<typename T = ErrorType>
 		requires std::is_constructible_v<ErrorType, T>
 	constexpr explicit(!std::is_convertible_v<T, ErrorType>)
-	result(error<T>&& error)
+	result(error<T>&& error U_DETAIL_ERROR_SITE)
 	noexcept(std::is_nothrow_constructible_v<ErrorType, T>)
-		: m_error{std::move(error).error()},
-		  m_has_value{false}
-	{}
+		: m_storage{u::error_tag, std::move(error).get()}
+	{
+		U_DETAIL_COUNT_ERROR();
+		U_DETAIL_SAMPLE_ERROR();
+	}
 
 	constexpr explicit result(std::in_place_t) noexcept
-		: m_value{}
-	{}
-
-	template<typename... Ts>
-		requires std::is_constructible_v<ValueType, Ts...>
-	constexpr explicit result(std::in_place_t, Ts&&... args)
-	noexcept(std::is_nothrow_constructible_v<ValueType, Ts...>)
-		: m_value{std::forward<Ts>(args)...}
-	{}
-
-	template<typename T, typename... Ts>
-		requires m_is_constructible_with_il_v<ValueType, T, Ts...>
-	constexpr explicit result(std::in_place_t,
-				  std::initializer_list<T> list,
-				  Ts&&...		   args)
-	noexcept(m_is_nothrow_constructible_with_il_v<ValueType, T, Ts...>)
-		: m_value{list, std::forward<Ts>(args)...}
+		: m_storage{std::in_place}
 	{}
 
 	template<typename... Ts>
 		requires std::is_constructible_v<ErrorType, Ts...>
 	constexpr explicit result(u::error_tag_t, Ts&&... args)
 	noexcept(std::is_nothrow_constructible_v<ErrorType, Ts...>)
-		: m_value{std::forward<Ts>(args)...}
-	{}
+		: m_storage{u::error_tag, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
 
 	template<typename T, typename... Ts>
-		requires m_is_constructible_with_il_v<ErrorType, T, Ts...>
+		requires m_is_constructible_with_il_v<T, Ts...>
 	constexpr explicit result(
 		u::error_tag_t,
 		std::initializer_list<T> list,
 		Ts&&...			 args)
-	noexcept(m_is_nothrow_constructible_with_il_v<ErrorType, T, Ts...>)
-		: m_value{list, std::forward<Ts>(args)...}
-	{}
+	noexcept(m_is_nothrow_constructible_with_il_v<T, Ts...>)
+		: m_storage{u::error_tag, list, std::forward<Ts>(args)...}
+	{ U_DETAIL_SAMPLE_ERROR(); }
 
 	constexpr ~result() = default;
 
-	constexpr ~result()
-	noexcept(conjunction_v<std::is_nothrow_destructible>)
-		requires disjunction_v<std::is_trivially_destructible>
-	{
-		if (this->m_has_value)
-			std::destroy_at(std::addressof(this->m_value));
-		else std::destroy_at(std::addressof(this->m_error));
-	}
-
-	result& operator=(const result&) = delete;
+	constexpr result& operator=(const result&)
+		requires m_is_trivially_copy_assignable_v
+	= default;
 
 	constexpr result& operator=(const result& other)
-	noexcept(m_is_nothrow_copy_or_move_assignable_v)
-		requires m_is_copy_or_move_assignable_v
+	noexcept(std::is_nothrow_copy_constructible_v<ErrorType>
+		&& std::is_nothrow_copy_assignable_v<ErrorType>)
+		requires std::is_copy_constructible_v<ErrorType>
+			&& std::is_copy_assignable_v<ErrorType>
+			&& (!m_is_trivially_copy_assignable_v)
 	{
-		if (other.m_has_value)
-			this->m_assign_value(other.m_value);
-		else this->m_assign_error(other.m_error);
+		if (other.has_value())
+			this->emplace();
+		else this->m_assign_error(other.m_storage.error());
 		return *this;
 	}
 
-	constexpr result& operator=(result&& other)
-	noexcept(m_is_nothrow_copy_or_move_assignable_v)
-		requires m_is_copy_or_move_assignable_v
-	{
-		if (other.m_has_value)
-			this->m_assign_value(std::move(other.m_value));
-		else this->m_assign_error(std::move(other.m_error));
-		return *this;
-	}
+	constexpr result& operator=(result&&)
+		requires m_is_trivially_move_assignable_v
+	= default;
 
-	template<typename T = ValueType>
-		requires (!std::is_same_v<std::remove_cvref_t<T>, result>)
-			&& (!is_error_v<std::remove_cvref_t<T>>)
-			&& std::is_constructible_v<ValueType, T>
-			&& std::is_assignable_v<ValueType&, T>
-			&& (std::is_nothrow_constructible_v<ValueType, T>
-				|| disjunction_v<std::is_nothrow_move_constructible>)
-	constexpr result& operator=(T&& value)
+	constexpr result& operator=(result&& other)
+	noexcept(std::is_nothrow_move_constructible_v<ErrorType>
+		&& std::is_nothrow_move_assignable_v<ErrorType>)
+		requires std::is_move_constructible_v<ErrorType>
+			&& std::is_move_assignable_v<ErrorType>
+			&& (!m_is_trivially_move_assignable_v)
 	{
-		this->m_assign_value(std::forward<T>(value));
+		if (other.has_value())
+			this->emplace();
+		else this->m_assign_error(std::move(other.m_storage.error()));
 		return *this;
 	}
 
 	template<typename T>
-		requires m_is_assignable_with_error_v<T>
+		requires m_is_assignable_with_error_v<const T&>
 	constexpr result& operator=(const error<T>& error)
 	{
-		this->m_assign_error(error.error());
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(error.get());
 		return *this;
 	}
 
@@ -572,135 +2061,90 @@ public:
 		requires m_is_assignable_with_error_v<T>
 	constexpr result& operator=(error<T>&& error)
 	{
-		this->m_assign_error(std::move(error).error());
+		U_DETAIL_SAMPLE_ERROR();
+		this->m_assign_error(std::move(error).get());
 		return *this;
 	}
 
+	constexpr void emplace() noexcept
+	{
+		if (!this->has_value())
+			this->m_storage.emplace_value(unit{});
+	}
+
 	//
 	// Observers
 	//
 
-	constexpr operator bool() const noexcept
-	{ return this->m_has_value; }
+	constexpr explicit operator bool() const noexcept
+	{ return this->m_storage.has_value(); }
 
 	[[nodiscard]]
 	constexpr bool has_value() const noexcept
-	{ return this->m_has_value; }
-
-	[[nodiscard]]
-	constexpr const ValueType* operator->() noexcept
-	{ return this->m_value; }
-
-	[[nodiscard]]
-	constexpr const ValueType* operator->() const noexcept
-	{ return this->m_value; }
-
-	[[nodiscard]]
-	constexpr ValueType& operator*() & noexcept
-	{ return this->m_value; }
-
-	[[nodiscard]]
-	constexpr const ValueType& operator*() const& noexcept
-	{ return this->m_value; }
-
-	[[nodiscard]]
-	constexpr ValueType&& operator*() && noexcept
-	{ return this->m_value; }
-
-	[[nodiscard]]
-	constexpr ValueType& value() &
-	{
-		if (!this->m_has_value) [[unlikely]]
-			U_THROW(bad_result_access{this->m_error});
-		return this->m_value;
-	}
+	{ return this->m_storage.has_value(); }
 
-	[[nodiscard]]
-	constexpr const ValueType& value() const&
+	constexpr void operator*() const
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
 	{
-		if (!this->m_has_value) [[unlikely]]
-			U_THROW(bad_result_access{this->m_error});
-		return this->m_value;
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
 	}
 
-	[[nodiscard]]
-	constexpr ValueType&& value() &&
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	constexpr void value() const&
+	noexcept(Policy != U_ACCESS_THROW)
 	{
-		if (!this->m_has_value) [[unlikely]]
-			U_THROW(bad_result_access{std::move(this->m_error)});
-		return this->m_value;
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
 	}
 
-	[[nodiscard]]
-	constexpr const ValueType&& value() const&&
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	constexpr void value() &&
+	noexcept(Policy != U_ACCESS_THROW)
 	{
-		if (!this->m_has_value) [[unlikely]]
-			U_THROW(bad_result_access{std::move(this->m_error)});
-		return this->m_value;
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(std::move(this->m_storage.error())); });
 	}
 
 	[[nodiscard]]
 	constexpr ErrorType& error() & noexcept
-	{ return this->m_error; }
-
-	[[nodiscard]]
-	constexpr ErrorType const& error() const&
-	{ return this->m_error; }
+	{ return this->m_storage.error(); }
 
 	[[nodiscard]]
-	constexpr ErrorType&& error() &&
-	{ return std::move(this->m_error); }
-
-	[[nodiscard]]
-	constexpr const ErrorType&& error() const&&
-	{ return std::move(this->m_error); }
+	constexpr const ErrorType& error() const& noexcept
+	{ return this->m_storage.error(); }
 
-	template<typename T = ValueType>
 	[[nodiscard]]
-	constexpr ValueType value_or(T&& other_value) const&
-	noexcept(std::is_nothrow_copy_constructible_v<ValueType>
-		&& std::is_nothrow_convertible_v<T, ValueType>)
-		requires std::is_convertible_v<T, ValueType>
-			&& std::is_copy_constructible_v<ValueType>
-	{
-		if (this->m_has_value)
-			return this->m_value;
-		return static_cast<ValueType>(std::forward<T>(other_value));
-	}
+	constexpr ErrorType&& error() && noexcept
+	{ return std::move(this->m_storage.error()); }
 
-	template<typename T = ValueType>
 	[[nodiscard]]
-	constexpr ValueType value_or(T&& value) &&
-	noexcept(std::is_nothrow_move_constructible_v<ValueType>
-		&& std::is_nothrow_convertible_v<T, ValueType>)
-		requires std::is_convertible_v<T, ValueType>
-			&& std::is_move_constructible_v<ValueType>
-	{ 
-		if (this->m_has_value)
-			return std::move(this->m_value);
-		return static_cast<ValueType>(std::forward<T>(value));
-	} 
+	constexpr const ErrorType&& error() const&& noexcept
+	{ return std::move(this->m_storage.error()); }
 
 	template<typename T = ErrorType>
 	[[nodiscard]]
-	constexpr ErrorType error_or(ErrorType&& error) const&
+	constexpr ErrorType error_or(T&& error) const&
 		requires std::is_convertible_v<T, ErrorType>
-			&& std::is_copy_constructible_v<T>
+			&& std::is_copy_constructible_v<ErrorType>
 	{
-		if (this->m_has_value)
+		if (this->has_value())
 			return std::forward<T>(error);
-		return this->m_error;
+		return this->m_storage.error();
 	}
 
 	template<typename T = ErrorType>
 	[[nodiscard]]
 	constexpr ErrorType error_or(T&& error) &&
 		requires std::is_convertible_v<T, ErrorType>
-			&& std::is_constructible_v<ErrorType, T>
+			&& std::is_move_constructible_v<ErrorType>
 	{
-		if (this->m_has_value)
+		if (this->has_value())
 			return std::forward<T>(error);
-		return std::move(this->m_error);
+		return std::move(this->m_storage.error());
 	}
 
 	//
@@ -711,150 +2155,121 @@ public:
 	constexpr auto and_then(F&& fn) &
 		requires std::is_constructible_v<ErrorType, ErrorType&>
 	{
-		using result_t = result::m_function_result_t<F, ValueType&>;
-		static_assert(result::m_is_valid_error_function_result_v<
+		using result_t = result::m_function_result_t<F>;
+		static_assert(result::m_is_valid_value_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return std::invoke(std::forward<F>(fn),this->m_value);
-		return result_t{u::error_tag, this->m_error};
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn));
+		return result_t{u::error_tag, this->m_storage.error()};
 	}
 
 	template<typename F>
 	constexpr auto and_then(F&& fn) const&
 		requires std::is_constructible_v<ErrorType, const ErrorType&>
 	{
-		using result_t = result::m_function_result_t<F, const ValueType&>;
-		static_assert(result::m_is_valid_error_function_result_v<
+		using result_t = result::m_function_result_t<F>;
+		static_assert(result::m_is_valid_value_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return std::invoke(std::forward<F>(fn),this->m_value);
-		return result_t{u::error_tag, this->m_error};
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn));
+		return result_t{u::error_tag, this->m_storage.error()};
 	}
 
 	template<typename F>
 	constexpr auto and_then(F&& fn) &&
 		requires std::is_constructible_v<ErrorType, ErrorType>
 	{
-		using result_t = result::m_function_result_t<F, ValueType&&>;
-		static_assert(result::m_is_valid_error_function_result_v<
+		using result_t = result::m_function_result_t<F>;
+		static_assert(result::m_is_valid_value_function_result_v<
 			result_t>);
 
-		if (!this->m_has_value)
-			return std::invoke(
-				std::forward<F>(fn),
-				std::move(this->m_error));
-		return result_t{std::in_place, std::move(this->m_value)};
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn));
+		return result_t{
+			u::error_tag,
+			std::move(this->m_storage.error())};
 	}
 
 	template<typename F>
 	constexpr auto and_then(F&& fn) const&&
 		requires std::is_constructible_v<ErrorType, const ErrorType>
 	{
-		using result_t = result::m_function_result_t<
-			F, const ValueType&&>;
-		static_assert(result::m_is_valid_error_function_result_v<
+		using result_t = result::m_function_result_t<F>;
+		static_assert(result::m_is_valid_value_function_result_v<
 			result_t>);
 
-		if (!this->m_has_value)
-			return std::invoke(
-				std::forward<F>(fn),
-				std::move(this->m_error));
-		return result_t{std::in_place, std::move(this->m_value)};
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn));
+		return result_t{
+			u::error_tag,
+			std::move(this->m_storage.error())};
 	}
 
 	template<typename F>
 	constexpr auto or_else(F&& fn) &
-		requires std::is_constructible_v<ValueType, ValueType&>
 	{
 		using result_t = result::m_function_result_t<F, ErrorType&>;
-		static_assert(result::m_is_valid_value_function_result_v<
+		static_assert(result::m_is_valid_error_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return result_t{std::in_place, this->m_value};
-		return std::invoke(std::forward<F>(fn), this->m_value);
+		if (this->has_value())
+			return result_t{};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
 	}
 
 	template<typename F>
 	constexpr auto or_else(F&& fn) const&
-		requires std::is_constructible_v<ValueType, const ValueType&>
 	{
 		using result_t = result::m_function_result_t<F, const ErrorType&>;
-		static_assert(result::m_is_valid_value_function_result_v<
+		static_assert(result::m_is_valid_error_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return result_t{std::in_place, this->m_value};
-		return std::invoke(std::forward<F>(fn), this->m_value);
+		if (this->has_value())
+			return result_t{};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
 	}
 
 	template<typename F>
 	constexpr auto or_else(F&& fn) &&
-		requires std::is_constructible_v<ValueType, ValueType&&>
 	{
 		using result_t = result::m_function_result_t<F, ErrorType&&>;
-		static_assert(result::m_is_valid_value_function_result_v<
+		static_assert(result::m_is_valid_error_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return result_t{
-				std::in_place,
-				std::move(this->m_value)};
+		if (this->has_value())
+			return result_t{};
 		return std::invoke(
 			std::forward<F>(fn),
-			std::move(this->m_value));
-	}	
+			std::move(this->m_storage.error()));
+	}
 
 	template<typename F>
 	constexpr auto or_else(F&& fn) const&&
-		requires std::is_constructible_v<ValueType, const ValueType&&>
 	{
 		using result_t = result::m_function_result_t<
 			F,
 			const ErrorType&&>;
-		static_assert(result::m_is_valid_value_function_result_v<
+		static_assert(result::m_is_valid_error_function_result_v<
 			result_t>);
 
-		if (this->m_has_value)
-			return result_t{
-				std::in_place,
-				std::move(this->m_value)};
+		if (this->has_value())
+			return result_t{};
 		return std::invoke(
 			std::forward<F>(fn),
-			std::move(this->m_value));
-	}	
+			std::move(this->m_storage.error()));
+	}
 
 private:
-	union {
-		ValueType m_value;
-		ErrorType m_error;
-	};
-	bool m_has_value{true};
-
-	template<typename T>
-	constexpr void m_assign_value(T&& value) noexcept
-	{
-		if (!this->m_has_value) {
-			detail::result_helpers::reconstruct(
-				std::addressof(this->m_value),
-				std::addressof(this->m_error),
-				std::forward<T>(value));
-			this->m_has_value = true;
-		} else this->m_value = std::forward<T>(value);
-	}
+	detail::result_helpers::storage_t<unit, ErrorType> m_storage;
 
 	template<typename T>
-	constexpr void m_assign_error(T&& error) noexcept
+	constexpr void m_assign_error(T&& error)
 	{
-		if (this->m_has_value) {
-			detail::result_helpers::reconstruct(
-				std::addressof(this->m_value),
-				std::addressof(this->m_error),
-				std::forward<T>(error));
-			this->m_has_value = false;
-		} else this->m_error = std::forward<T>(error);
+		if (this->has_value())
+			this->m_storage.emplace_error(std::forward<T>(error));
+		else this->m_storage.error() = std::forward<T>(error);
 	}
 };
 
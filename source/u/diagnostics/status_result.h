@@ -0,0 +1,320 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_STATUS_RESULT_H
+
+#include <u/config.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <u/diagnostics/result.h>
+
+namespace u
+{
+
+template<typename ValueType, typename CodeType>
+class status_result;
+
+template<typename T>
+struct is_status_result
+	: std::bool_constant<false>
+{};
+
+template<typename T, typename U>
+struct is_status_result<status_result<T, U>>
+	: std::bool_constant<true>
+{};
+
+template<typename T>
+constexpr bool is_status_result_v = u::is_status_result<T>::value;
+
+template<typename T>
+struct is_valid_status_code
+	: std::bool_constant<
+		(std::is_integral_v<T> || std::is_enum_v<T>)
+		&& !std::is_same_v<T, bool>
+		&& !std::is_const_v<T>
+		&& !std::is_volatile_v<T>>
+{};
+
+template<typename T>
+constexpr bool is_valid_status_code_v = u::is_valid_status_code<T>::value;
+
+namespace detail::status_result_helpers
+{
+
+template<typename T>
+constexpr auto to_integer(T code) noexcept
+{
+	if constexpr (std::is_enum_v<T>)
+		return static_cast<std::underlying_type_t<T>>(code);
+	else return code;
+}
+
+// Checks a precondition of the storage, which would otherwise turn a value
+// into an error or an error into a value. It traps when `NDEBUG` is not
+// defined, as `U_ACCESS_ASSERT` does, and always fails a constant
+// expression.
+constexpr void check_representable(bool representable) noexcept
+{
+#if defined NDEBUG
+	if (!std::is_constant_evaluated())
+		return;
+#endif
+	if (!representable) [[unlikely]]
+		__builtin_trap();
+}
+
+// The value and the code sit side by side in one machine word; a zero code
+// means success and the value is meaningless otherwise.
+template<typename ValueType, typename CodeType>
+struct packed_storage
+{
+	constexpr explicit packed_storage(std::in_place_t, ValueType value) noexcept
+		: m_value{value},
+		  m_code{}
+	{}
+
+	constexpr explicit packed_storage(u::error_tag_t, CodeType code) noexcept
+		: m_value{},
+		  m_code{code}
+	{ status_result_helpers::check_representable(code != CodeType{}); }
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_code == CodeType{}; }
+
+	[[nodiscard]]
+	constexpr ValueType value() const noexcept
+	{ return this->m_value; }
+
+	[[nodiscard]]
+	constexpr CodeType error() const noexcept
+	{ return this->m_code; }
+
+	ValueType m_value;
+	CodeType m_code;
+};
+
+// The convention of system calls: values are never negative, so a negative
+// word carries a negated code. This keeps `status_result<ssize_t, int>` in
+// one register although the two do not fit side by side.
+template<typename ValueType, typename CodeType>
+struct negated_storage
+{
+	constexpr explicit negated_storage(std::in_place_t, ValueType value) noexcept
+		: m_word{value}
+	{ status_result_helpers::check_representable(value >= 0); }
+
+	constexpr explicit negated_storage(u::error_tag_t, CodeType code) noexcept
+		: m_word{static_cast<ValueType>(
+			-static_cast<ValueType>(status_result_helpers::to_integer(code)))}
+	{
+		const auto integer = status_result_helpers::to_integer(code);
+		status_result_helpers::check_representable(
+			integer > 0
+			&& std::cmp_less_equal(integer, std::numeric_limits<ValueType>::max()));
+	}
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_word >= 0; }
+
+	[[nodiscard]]
+	constexpr ValueType value() const noexcept
+	{ return this->m_word; }
+
+	[[nodiscard]]
+	constexpr CodeType error() const noexcept
+	{ return static_cast<CodeType>(-this->m_word); }
+
+	ValueType m_word;
+};
+
+template<typename ValueType, typename CodeType>
+constexpr bool is_packable_v =
+	sizeof(ValueType) + sizeof(CodeType) <= sizeof(std::uint64_t);
+
+template<typename ValueType, typename CodeType>
+constexpr bool is_negatable_v =
+	std::is_integral_v<ValueType>
+	&& std::is_signed_v<ValueType>
+	&& sizeof(CodeType) <= sizeof(ValueType);
+
+template<typename ValueType, typename CodeType>
+using storage_t = std::conditional_t<
+	is_packable_v<ValueType, CodeType>,
+	packed_storage<ValueType, CodeType>,
+	negated_storage<ValueType, CodeType>>;
+
+}  // namespace detail::status_result_helpers
+
+// A result whose error is a status code, in which the zero code is reserved
+// for success, packed into a single machine word. The value must be
+// trivially copyable and, when it does not fit beside the code, a signed
+// integer that is never negative, and the code of an error then positive.
+// A value or a code which cannot be told apart from the other traps when
+// `NDEBUG` is not defined, and is rejected in a constant expression.
+template<typename ValueType, typename CodeType>
+class status_result
+{
+	static_assert(u::is_valid_status_code_v<CodeType>);
+	static_assert(std::is_trivially_copyable_v<ValueType>);
+	static_assert(
+		detail::status_result_helpers::is_packable_v<ValueType, CodeType>
+		|| detail::status_result_helpers::is_negatable_v<ValueType, CodeType>,
+		"the value and the code do not fit in a word (use u::result)");
+
+public:
+	using value_type = ValueType;
+	using error_type = CodeType;
+
+private:
+	template<typename F, typename T>
+	using m_function_result_t =
+		std::remove_cvref_t<
+			std::invoke_result_t<F&&, T&&>>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_value_function_result_v =
+		(u::is_status_result_v<T> || u::is_result_v<T>)
+		&& std::is_same_v<typename T::error_type, CodeType>;
+
+	template<typename T>
+	static constexpr bool m_is_valid_error_function_result_v =
+		(u::is_status_result_v<T> || u::is_result_v<T>)
+		&& std::is_same_v<typename T::value_type, ValueType>;
+
+public:
+	constexpr status_result() noexcept
+		: m_storage{std::in_place, ValueType{}}
+	{}
+
+	constexpr status_result(ValueType value) noexcept
+		: m_storage{std::in_place, value}
+	{}
+
+	constexpr status_result(u::error<CodeType> code) noexcept
+		: m_storage{u::error_tag, code.get()}
+	{}
+
+	constexpr explicit status_result(std::in_place_t, ValueType value) noexcept
+		: m_storage{std::in_place, value}
+	{}
+
+	constexpr explicit status_result(u::error_tag_t, CodeType code) noexcept
+		: m_storage{u::error_tag, code}
+	{}
+
+	constexpr explicit status_result(const u::result<ValueType, CodeType>& other)
+	noexcept
+		: m_storage{other.has_value()
+			? storage_type{std::in_place, *other}
+			: storage_type{u::error_tag, other.error()}}
+	{}
+
+	[[nodiscard]]
+	constexpr operator u::result<ValueType, CodeType>() const noexcept
+	{
+		if (this->has_value())
+			return u::result<ValueType, CodeType>{
+				std::in_place,
+				this->m_storage.value()};
+		return u::result<ValueType, CodeType>{
+			u::error_tag,
+			this->m_storage.error()};
+	}
+
+	//
+	// Observers
+	//
+
+	constexpr explicit operator bool() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr bool has_value() const noexcept
+	{ return this->m_storage.has_value(); }
+
+	[[nodiscard]]
+	constexpr ValueType operator*() const
+	noexcept(U_RESULT_DEREFERENCE_ACCESS != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<U_RESULT_DEREFERENCE_ACCESS>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	template<int Policy = U_RESULT_VALUE_ACCESS>
+	[[nodiscard]]
+	constexpr ValueType value() const
+	noexcept(Policy != U_ACCESS_THROW)
+	{
+		detail::result_helpers::check_access<Policy>(
+			this->has_value(),
+			[&] { detail::result_helpers::throw_bad_access(this->m_storage.error()); });
+		return this->m_storage.value();
+	}
+
+	[[nodiscard]]
+	constexpr CodeType error() const noexcept
+	{ return this->m_storage.error(); }
+
+	[[nodiscard]]
+	constexpr ValueType value_or(ValueType other) const noexcept
+	{
+		if (this->has_value())
+			return this->m_storage.value();
+		return other;
+	}
+
+	[[nodiscard]]
+	constexpr CodeType error_or(CodeType other) const noexcept
+	{
+		if (this->has_value())
+			return other;
+		return this->m_storage.error();
+	}
+
+	//
+	// Monadic Operations
+	//
+
+	template<typename F>
+	constexpr auto and_then(F&& fn) const
+	{
+		using result_t = status_result::m_function_result_t<F, ValueType>;
+		static_assert(status_result::m_is_valid_value_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return std::invoke(std::forward<F>(fn), this->m_storage.value());
+		return result_t{u::error_tag, this->m_storage.error()};
+	}
+
+	template<typename F>
+	constexpr auto or_else(F&& fn) const
+	{
+		using result_t = status_result::m_function_result_t<F, CodeType>;
+		static_assert(status_result::m_is_valid_error_function_result_v<
+			result_t>);
+
+		if (this->has_value())
+			return result_t{std::in_place, this->m_storage.value()};
+		return std::invoke(std::forward<F>(fn), this->m_storage.error());
+	}
+
+private:
+	using storage_type =
+		detail::status_result_helpers::storage_t<ValueType, CodeType>;
+
+	storage_type m_storage;
+};
+
+}
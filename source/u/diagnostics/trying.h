@@ -0,0 +1,66 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_DIAGNOSTICS_TRYING_H
+
+#include <u/config.h>
+
+#include <utility>
+
+#include <u/diagnostics/result.h>
+
+namespace u
+{
+
+namespace detail::try_helpers
+{
+
+// Building the error is kept out of line and marked cold so that the
+// caller's hot path is just the check and a branch to this call.
+template<typename Result>
+[[gnu::cold, gnu::noinline]]
+constexpr auto propagate(Result&& result)
+{ return u::error{std::forward<Result>(result).error()}; }
+
+}  // namespace detail::try_helpers
+
+#define U_DETAIL_CONCAT_(a, b) a##b
+#define U_DETAIL_CONCAT(a, b) U_DETAIL_CONCAT_(a, b)
+
+// Evaluates to the value of a result, or returns its error from the
+// enclosing function:
+//
+//	const auto header = U_TRY(parse_header(input));
+#define U_TRY(...) \
+	({ \
+		auto&& u_try_result_ = (__VA_ARGS__); \
+		if (!u_try_result_.has_value()) [[unlikely]] \
+			return ::u::detail::try_helpers::propagate( \
+				static_cast<decltype(u_try_result_)&&>(u_try_result_)); \
+		*static_cast<decltype(u_try_result_)&&>(u_try_result_); \
+	})
+
+// Like `U_TRY`, but declares or assigns in the enclosing scope, which also
+// works for values that cannot be moved out of a statement expression:
+//
+//	U_TRY_ASSIGN(auto& entry, lookup(key));
+#define U_TRY_ASSIGN(target, ...) \
+	U_DETAIL_TRY_ASSIGN( \
+		U_DETAIL_CONCAT(u_try_result_, __COUNTER__), \
+		target, \
+		__VA_ARGS__)
+
+#define U_DETAIL_TRY_ASSIGN(name, target, ...) \
+	auto&& name = (__VA_ARGS__); \
+	if (!name.has_value()) [[unlikely]] \
+		return ::u::detail::try_helpers::propagate( \
+			static_cast<decltype(name)&&>(name)); \
+	target = *static_cast<decltype(name)&&>(name)
+
+#if defined U_ENABLE_UNPREFIXED_MACROS
+#	define TRY U_TRY
+#	define TRY_ASSIGN U_TRY_ASSIGN
+#endif
+
+}
@@ -0,0 +1,386 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_GRAMMAR_H
+
+#include <u/config.h>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+
+// Parser combinators. A parser is a constant object which takes the input
+// and returns the value it parsed from the start of the input, with the
+// number of characters it parsed, as `u::parse` does:
+//
+//	constexpr auto token = u::grammar::many(
+//		u::grammar::character(u::grammar::character_set::range('a', 'z')),
+//		1);
+//	constexpr auto pair = u::grammar::map(
+//		u::grammar::sequence(token, u::grammar::literal("="), token),
+//		[](std::string_view key, std::string_view, std::string_view value) {
+//			return std::pair{key, value};
+//		});
+//
+//	u::result<u::parsed<std::pair<std::string_view, std::string_view>>,
+//		u::parse_error> parsed = pair("key=value");
+//
+// The grammar is the type of the parser, so the compiler sees all of it at
+// once and inlines it into a single function with no indirect calls.
+
+namespace u::grammar
+{
+
+template<typename T>
+using parse_result = u::result<u::parsed<T>, u::parse_error>;
+
+template<typename P>
+concept parser = requires(const P& parser, std::string_view input) {
+	typename P::value_type;
+	{ parser(input) } -> std::same_as<parse_result<typename P::value_type>>;
+};
+
+template<typename P>
+using value_t = typename P::value_type;
+
+// A set of the 256 values of `char`, as a table with an entry for each so
+// that a lookup is a single load.
+class character_set
+{
+public:
+	constexpr character_set() noexcept = default;
+
+	constexpr explicit character_set(std::string_view characters) noexcept
+	{
+		for (const char c : characters)
+			this->m_contains[character_set::m_index(c)] = true;
+	}
+
+	[[nodiscard]]
+	static constexpr character_set range(char first, char last) noexcept
+	{
+		character_set set;
+		for (unsigned c = character_set::m_index(first);
+				c <= character_set::m_index(last);
+				++c)
+			set.m_contains[c] = true;
+		return set;
+	}
+
+	[[nodiscard]]
+	constexpr bool contains(char c) const noexcept
+	{ return this->m_contains[character_set::m_index(c)]; }
+
+	[[nodiscard]]
+	constexpr character_set operator~() const noexcept
+	{
+		character_set set;
+		for (std::size_t i{0}; i < 256; ++i)
+			set.m_contains[i] = !this->m_contains[i];
+		return set;
+	}
+
+	[[nodiscard]]
+	friend constexpr character_set operator|(
+		const character_set& a,
+		const character_set& b) noexcept
+	{
+		character_set set;
+		for (std::size_t i{0}; i < 256; ++i)
+			set.m_contains[i] = a.m_contains[i] || b.m_contains[i];
+		return set;
+	}
+
+	[[nodiscard]]
+	friend constexpr character_set operator-(
+		const character_set& a,
+		const character_set& b) noexcept
+	{
+		character_set set;
+		for (std::size_t i{0}; i < 256; ++i)
+			set.m_contains[i] = a.m_contains[i] && !b.m_contains[i];
+		return set;
+	}
+
+private:
+	std::array<bool, 256> m_contains{};
+
+	static constexpr unsigned m_index(char c) noexcept
+	{ return static_cast<unsigned char>(c); }
+};
+
+namespace detail
+{
+
+[[nodiscard]]
+constexpr u::error<u::parse_error> mismatch() noexcept
+{ return u::error<u::parse_error>{u::parse_error::invalid_argument}; }
+
+// The rest of the input after the `length` characters parsed, without the
+// bounds check of `substr`.
+[[nodiscard]]
+constexpr std::string_view after(std::string_view input, std::size_t length) noexcept
+{ return std::string_view{input.data() + length, input.size() - length}; }
+
+template<typename F, typename T>
+[[nodiscard]]
+constexpr decltype(auto) apply(F& fn, T&& value)
+{
+	if constexpr (std::is_invocable_v<F&, T>)
+		return std::invoke(fn, std::forward<T>(value));
+	else return std::apply(fn, std::forward<T>(value));
+}
+
+}  // namespace detail
+
+// Matches one character of a set.
+struct character_parser
+{
+	using value_type = char;
+
+	character_set m_set;
+
+	[[nodiscard]]
+	constexpr parse_result<char> operator()(std::string_view input) const noexcept
+	{
+		if (input.empty() || !this->m_set.contains(input.front()))
+			return detail::mismatch();
+		return u::parsed<char>{input.front(), 1};
+	}
+};
+
+// Matches a string exactly.
+struct literal_parser
+{
+	using value_type = std::string_view;
+
+	std::string_view m_text;
+
+	[[nodiscard]]
+	constexpr parse_result<std::string_view> operator()(
+		std::string_view input) const noexcept
+	{
+		// Literals are short, and comparing them in place is cheaper than
+		// a call to `memcmp`.
+		if (input.size() < this->m_text.size())
+			return detail::mismatch();
+		for (std::size_t i{0}; i < this->m_text.size(); ++i)
+			if (input[i] != this->m_text[i])
+				return detail::mismatch();
+		return u::parsed<std::string_view>{this->m_text, this->m_text.size()};
+	}
+};
+
+// Matches a number, as `u::parse` does.
+template<typename T>
+	requires u::parsable_integer<T> || u::parsable_floating_point<T>
+struct number_parser
+{
+	using value_type = T;
+
+	[[nodiscard]]
+	constexpr parse_result<T> operator()(std::string_view input) const noexcept
+	{ return u::parse<T>(input); }
+};
+
+// Matches each parser after the one before, and gives their values as a
+// tuple.
+template<parser... Ps>
+struct sequence_parser
+{
+	using value_type = std::tuple<value_t<Ps>...>;
+
+	std::tuple<Ps...> m_parsers;
+
+	[[nodiscard]]
+	constexpr parse_result<value_type> operator()(std::string_view input) const
+	{ return this->m_parse<0>(input, 0); }
+
+private:
+	template<std::size_t Index, typename... Ts>
+	constexpr parse_result<value_type> m_parse(
+		std::string_view input,
+		std::size_t length,
+		Ts&&... values) const
+	{
+		if constexpr (Index == sizeof...(Ps)) {
+			return u::parsed<value_type>{
+				value_type{std::forward<Ts>(values)...},
+				length};
+		} else {
+			auto parsed = std::get<Index>(this->m_parsers)(
+				detail::after(input, length));
+			if (!parsed.has_value())
+				return u::error<u::parse_error>{parsed.error()};
+			return this->m_parse<Index + 1>(
+				input,
+				length + parsed->length,
+				std::forward<Ts>(values)...,
+				std::move(parsed->value));
+		}
+	}
+};
+
+// Matches the first of the parsers which matches, and fails with the error
+// of the last when none does.
+template<parser... Ps>
+struct choice_parser
+{
+	using value_type = std::common_type_t<value_t<Ps>...>;
+
+	std::tuple<Ps...> m_parsers;
+
+	[[nodiscard]]
+	constexpr parse_result<value_type> operator()(std::string_view input) const
+	{ return this->m_parse<0>(input); }
+
+private:
+	template<std::size_t Index>
+	constexpr parse_result<value_type> m_parse(std::string_view input) const
+	{
+		auto parsed = std::get<Index>(this->m_parsers)(input);
+		if constexpr (Index + 1 != sizeof...(Ps))
+			if (!parsed.has_value())
+				return this->m_parse<Index + 1>(input);
+		if (!parsed.has_value())
+			return u::error<u::parse_error>{parsed.error()};
+		return u::parsed<value_type>{
+			value_type(std::move(parsed->value)),
+			parsed->length};
+	}
+};
+
+// Matches the parser as many times as it matches, and at least `m_minimum`
+// times, and gives the text it matched.
+template<parser P>
+struct many_parser
+{
+	using value_type = std::string_view;
+
+	P m_parser;
+	std::size_t m_minimum;
+
+	[[nodiscard]]
+	constexpr parse_result<std::string_view> operator()(
+		std::string_view input) const
+	{
+		std::size_t count{0};
+		std::size_t length{0};
+		if constexpr (std::is_same_v<P, character_parser>) {
+			// Runs of characters are the common case, and are scanned
+			// without a result per character.
+			while (length != input.size()
+					&& this->m_parser.m_set.contains(input[length]))
+				++length;
+			count = length;
+		} else for (;; ++count) {
+			const auto parsed = this->m_parser(detail::after(input, length));
+			// A match of nothing would match forever.
+			if (!parsed.has_value() || parsed->length == 0)
+				break;
+			length += parsed->length;
+		}
+		if (count < this->m_minimum)
+			return detail::mismatch();
+		return u::parsed<std::string_view>{
+			std::string_view{input.data(), length},
+			length};
+	}
+};
+
+// Matches the parser or nothing.
+template<parser P>
+struct optional_parser
+{
+	using value_type = std::optional<value_t<P>>;
+
+	P m_parser;
+
+	[[nodiscard]]
+	constexpr parse_result<value_type> operator()(std::string_view input) const
+	{
+		auto parsed = this->m_parser(input);
+		if (!parsed.has_value())
+			return u::parsed<value_type>{std::nullopt, 0};
+		return u::parsed<value_type>{
+			value_type{std::move(parsed->value)},
+			parsed->length};
+	}
+};
+
+// Matches the parser and replaces its value with `fn(value)`, or with
+// `fn(values...)` when the value is a tuple.
+template<parser P, typename F>
+struct map_parser
+{
+	using value_type = std::remove_cvref_t<decltype(detail::apply(
+		std::declval<const F&>(),
+		std::declval<value_t<P>>()))>;
+
+	P m_parser;
+	F m_fn;
+
+	[[nodiscard]]
+	constexpr parse_result<value_type> operator()(std::string_view input) const
+	{
+		auto parsed = this->m_parser(input);
+		if (!parsed.has_value())
+			return u::error<u::parse_error>{parsed.error()};
+		return u::parsed<value_type>{
+			detail::apply(this->m_fn, std::move(parsed->value)),
+			parsed->length};
+	}
+};
+
+[[nodiscard]]
+constexpr character_parser character(character_set set) noexcept
+{ return character_parser{set}; }
+
+[[nodiscard]]
+constexpr literal_parser literal(std::string_view text) noexcept
+{ return literal_parser{text}; }
+
+template<typename T>
+inline constexpr number_parser<T> number{};
+
+template<parser... Ps>
+[[nodiscard]]
+constexpr sequence_parser<Ps...> sequence(Ps... parsers)
+{ return sequence_parser<Ps...>{{std::move(parsers)...}}; }
+
+template<parser... Ps>
+	requires (sizeof...(Ps) != 0)
+[[nodiscard]]
+constexpr choice_parser<Ps...> choice(Ps... parsers)
+{ return choice_parser<Ps...>{{std::move(parsers)...}}; }
+
+template<parser P>
+[[nodiscard]]
+constexpr many_parser<P> many(P parser, std::size_t minimum = 0)
+{ return many_parser<P>{std::move(parser), minimum}; }
+
+template<parser P>
+[[nodiscard]]
+constexpr optional_parser<P> optional(P parser)
+{ return optional_parser<P>{std::move(parser)}; }
+
+template<parser P, typename F>
+[[nodiscard]]
+constexpr map_parser<P, std::decay_t<F>> map(P parser, F&& fn)
+{
+	return map_parser<P, std::decay_t<F>>{
+		std::move(parser),
+		std::forward<F>(fn)};
+}
+
+}
@@ -0,0 +1,989 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_JSON_H
+
+#include <u/config.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined __AVX2__ || defined __PCLMUL__ || defined __SSE2__
+#	include <immintrin.h>
+#endif
+
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+#include <u/utf8.h>
+
+// Parses JSON in two passes, after Langdale and Lemire, "Parsing Gigabytes
+// of JSON per Second":
+//
+//	auto document = u::json::document::parse(text);
+//	auto price = document->root()["items"]
+//		.and_then([](u::json::value items) { return items[0]; })
+//		.and_then([](u::json::value item) { return item["price"]; })
+//		.and_then([](u::json::value price) { return price.get<double>(); });
+//
+// The first pass finds the structural characters (brackets, colons, commas,
+// and the starts of strings and of other values) 64 bytes at a time, with
+// quotes inside strings and escaped quotes masked out by a prefix XOR. The
+// second pass checks the structure and records where every value ends, so
+// that values which are not asked for are skipped in one step. Strings and
+// numbers are only read, and their errors only found, when they are asked
+// for. The names of fields are the exception: lookups compare them as they
+// are written, so their escapes are checked by the second pass.
+
+namespace u::json
+{
+
+enum class error : std::uint8_t
+{
+	// The text is not valid UTF-8.
+	invalid_utf8 = 1,
+	// A string is not closed before the end of the text.
+	unclosed_string,
+	// A character which cannot appear where it does.
+	unexpected_character,
+	// The text ends before the value does.
+	unexpected_end,
+	// A word other than `true`, `false` or `null`.
+	invalid_literal,
+	invalid_number,
+	number_out_of_range,
+	// A string with a control character or an invalid escape.
+	invalid_string,
+	// The value is not of the type it is read as.
+	incorrect_type,
+	no_such_field,
+	index_out_of_range,
+	// The text is longer than 4 GiB.
+	too_large
+};
+
+template<typename T>
+using result = u::result<T, u::located<json::error>>;
+
+enum class kind : std::uint8_t
+{
+	object,
+	array,
+	string,
+	number,
+	boolean,
+	null
+};
+
+namespace detail
+{
+
+[[nodiscard]]
+inline u::error<u::located<json::error>> fail(
+	json::error error,
+	std::size_t offset) noexcept
+{ return u::error<u::located<json::error>>{std::in_place, error, offset}; }
+
+[[nodiscard]]
+constexpr bool is_whitespace(char c) noexcept
+{ return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+[[nodiscard]]
+constexpr bool is_operator(char c) noexcept
+{
+	return c == '{' || c == '}' || c == '[' || c == ']'
+		|| c == ':' || c == ',';
+}
+
+// One bit per byte of a 64-byte block.
+struct block_masks
+{
+	std::uint64_t backslashes;
+	std::uint64_t quotes;
+	std::uint64_t operators;
+	std::uint64_t whitespace;
+};
+
+[[nodiscard]]
+constexpr block_masks classify_scalar(const char* block) noexcept
+{
+	block_masks masks{};
+	for (std::size_t i{0}; i < 64; ++i) {
+		const std::uint64_t bit = std::uint64_t{1} << i;
+		masks.backslashes |= block[i] == '\\' ? bit : 0;
+		masks.quotes |= block[i] == '"' ? bit : 0;
+		masks.operators |= detail::is_operator(block[i]) ? bit : 0;
+		masks.whitespace |= detail::is_whitespace(block[i]) ? bit : 0;
+	}
+	return masks;
+}
+
+#if defined __AVX2__
+
+// Whitespace and operators are told apart by a lookup on the low nibble,
+// since no two of each share one. Setting 0x20 folds `[` and `]` onto `{`
+// and `}`; the control characters it folds onto `:` and `,` are invalid
+// outside strings and are refused by the second pass.
+alignas(16) inline constexpr char whitespace_table[16]{
+	' ', 0, 0, 0, 0, 0, 0, 0, 0, '\t', '\n', 0, 0, '\r', 0, 0};
+
+alignas(16) inline constexpr char operator_table[16]{
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0};
+
+[[nodiscard]]
+inline block_masks classify_avx2(const char* block) noexcept
+{
+	const __m256i whitespace = _mm256_broadcastsi128_si256(
+		_mm_load_si128(reinterpret_cast<const __m128i*>(whitespace_table)));
+	const __m256i operators = _mm256_broadcastsi128_si256(
+		_mm_load_si128(reinterpret_cast<const __m128i*>(operator_table)));
+
+	block_masks masks{};
+	for (std::size_t half{0}; half < 2; ++half) {
+		const __m256i bytes = _mm256_loadu_si256(
+			reinterpret_cast<const __m256i*>(block + 32 * half));
+		const auto bits = [&](__m256i matches) {
+			return std::uint64_t{static_cast<std::uint32_t>(
+				_mm256_movemask_epi8(matches))} << (32 * half);
+		};
+		masks.backslashes |= bits(
+			_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\')));
+		masks.quotes |= bits(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')));
+		masks.whitespace |= bits(_mm256_cmpeq_epi8(
+			_mm256_shuffle_epi8(whitespace, bytes),
+			bytes));
+		masks.operators |= bits(_mm256_cmpeq_epi8(
+			_mm256_shuffle_epi8(operators, bytes),
+			_mm256_or_si256(bytes, _mm256_set1_epi8(0x20))));
+	}
+	return masks;
+}
+
+#endif
+
+// Each bit set to the XOR of the bits up to and including it, which turns
+// the quotes into the spans of the strings they delimit.
+[[nodiscard]]
+constexpr std::uint64_t prefix_xor(std::uint64_t bits) noexcept
+{
+#if defined __PCLMUL__
+	if (!std::is_constant_evaluated())
+		return static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_clmulepi64_si128(
+			_mm_set_epi64x(0, static_cast<long long>(bits)),
+			_mm_set1_epi8(static_cast<char>(0xFF)),
+			0)));
+#endif
+	for (int shift{1}; shift < 64; shift *= 2)
+		bits ^= bits << shift;
+	return bits;
+}
+
+// The characters escaped by an odd run of backslashes. `escaped` carries
+// whether the first character of the next block is.
+[[nodiscard]]
+constexpr std::uint64_t find_escaped(
+	std::uint64_t backslashes,
+	std::uint64_t& escaped) noexcept
+{
+	constexpr std::uint64_t even_bits{0x5555555555555555};
+
+	backslashes &= ~escaped;
+	const std::uint64_t follows_escape = backslashes << 1 | escaped;
+	const std::uint64_t odd_starts = backslashes & ~even_bits & ~follows_escape;
+	std::uint64_t even_starts;
+	escaped = __builtin_add_overflow(odd_starts, backslashes, &even_starts);
+	return (even_bits ^ (even_starts << 1)) & follows_escape;
+}
+
+// The structural characters, and for each value the index of the
+// structural character after it.
+struct index
+{
+	std::string_view text;
+	std::unique_ptr<std::uint32_t[]> positions;
+	std::unique_ptr<std::uint32_t[]> next;
+	std::size_t count;
+
+	[[nodiscard]]
+	char at(std::uint32_t structural) const noexcept
+	{ return this->text[this->positions[structural]]; }
+};
+
+// Finds the structural characters of `text`, or fails if a string is not
+// closed.
+[[nodiscard]]
+inline json::result<void> find_structurals(index& index)
+{
+	const std::string_view text = index.text;
+	index.positions = std::make_unique_for_overwrite<std::uint32_t[]>(
+		text.size() + 64);
+
+	std::uint64_t escaped{0};
+	std::uint64_t in_string{0};
+	std::uint64_t in_word{0};
+	std::size_t count{0};
+
+	alignas(64) char padded[64];
+	for (std::size_t base{0}; base < text.size(); base += 64) {
+		const char* block = text.data() + base;
+		if (text.size() - base < 64) {
+			std::memset(padded, ' ', sizeof(padded));
+			std::memcpy(padded, block, text.size() - base);
+			block = padded;
+		}
+
+#if defined __AVX2__
+		const block_masks masks = detail::classify_avx2(block);
+#else
+		const block_masks masks = detail::classify_scalar(block);
+#endif
+
+		const std::uint64_t quotes =
+			masks.quotes & ~detail::find_escaped(masks.backslashes, escaped);
+		const std::uint64_t strings = detail::prefix_xor(quotes) ^ in_string;
+		in_string = static_cast<std::uint64_t>(
+			static_cast<std::int64_t>(strings) >> 63);
+
+		// Outside strings, everything but operators and whitespace belongs
+		// to a word, such as a number or `true`, which is indexed by its
+		// first character.
+		const std::uint64_t outside = ~(strings | quotes);
+		const std::uint64_t words = outside & ~(masks.operators | masks.whitespace);
+		const std::uint64_t word_starts = words & ~(words << 1 | in_word);
+		in_word = words >> 63;
+
+		std::uint64_t structurals = (masks.operators & outside)
+			| (quotes & strings)
+			| word_starts;
+		// Writes eight positions at a time without a branch on each, into
+		// room past the end which `positions` keeps for this.
+		const std::size_t found = static_cast<std::size_t>(
+			std::popcount(structurals));
+		std::uint32_t* out = index.positions.get() + count;
+		for (std::size_t k{0}; k < found; k += 8)
+			for (std::size_t j{0}; j < 8; ++j) {
+				out[k + j] = static_cast<std::uint32_t>(base
+					+ static_cast<std::size_t>(std::countr_zero(structurals)));
+				structurals &= structurals - 1;
+			}
+		count += found;
+	}
+	index.count = count;
+
+	// Nothing inside a string is indexed, so an open string started at the
+	// last structural character.
+	if (in_string != 0)
+		return detail::fail(
+			json::error::unclosed_string,
+			index.positions[count - 1]);
+	return {};
+}
+
+// Whether the word at `position` is exactly `literal`.
+[[nodiscard]]
+constexpr bool is_literal(
+	std::string_view text,
+	std::size_t position,
+	std::string_view literal) noexcept
+{
+	const std::size_t end = position + literal.size();
+	return text.substr(position, literal.size()) == literal
+		&& (end == text.size()
+			|| detail::is_whitespace(text[end])
+			|| detail::is_operator(text[end]));
+}
+
+[[nodiscard]]
+inline json::result<std::string> unescape(std::string_view text, std::size_t base);
+
+// Checks the name of the field whose opening quote is the structural
+// character `at`. Names are checked when the text is parsed, unlike strings
+// which are values, since every lookup reads them as they are written.
+[[nodiscard]]
+inline json::result<void> check_key(const index& index, std::uint32_t at)
+{
+	const std::string_view text = index.text;
+	const std::size_t first = index.positions[at] + 1;
+
+#if defined __SSE2__
+	// Most names hold neither escapes nor control characters, which is seen
+	// sixteen bytes at a time up to the colon after the name.
+	if (at + 1 < index.count && index.positions[at + 1] >= 16) {
+		const std::size_t colon = index.positions[at + 1];
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x1F);
+		std::uint32_t special{0};
+		for (std::size_t block = first; block < colon && special == 0; block += 16) {
+			const std::size_t start = std::min(block, colon - 16);
+			const __m128i bytes = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(text.data() + start));
+			special = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(
+				_mm_cmpeq_epi8(bytes, backslash),
+				_mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control))));
+			// The bytes before the name, when it is shorter than a block.
+			if (start < first)
+				special &= ~std::uint32_t{0} << (first - start);
+		}
+		if (special == 0)
+			return {};
+	}
+#endif
+
+	// The first pass found the closing quote, so the name ends before the
+	// end of the text.
+	bool plain{true};
+	std::size_t last = first;
+	for (; text[last] != '"'; ++last) {
+		if (text[last] == '\\') {
+			plain = false;
+			++last;
+		} else if (static_cast<unsigned char>(text[last]) < 0x20)
+			plain = false;
+	}
+	if (plain)
+		return {};
+
+	const auto unescaped = detail::unescape(text.substr(first, last - first), first);
+	if (!unescaped.has_value())
+		return u::error<u::located<json::error>>{unescaped.error()};
+	return {};
+}
+
+// Checks the grammar over the structural characters, and records where each
+// value ends.
+[[nodiscard]]
+inline json::result<void> check_structure(index& index)
+{
+	enum class expect : std::uint8_t
+	{
+		value,
+		value_or_close,
+		key,
+		key_or_close,
+		colon,
+		comma_or_close,
+		end
+	};
+
+	index.next = std::make_unique_for_overwrite<std::uint32_t[]>(index.count);
+	const char* const text = index.text.data();
+	const std::uint32_t* const positions = index.positions.get();
+	std::uint32_t* const next = index.next.get();
+
+	// The open objects and arrays, and whether the innermost is an object.
+	std::vector<std::uint32_t> open;
+	bool in_object{false};
+	expect state = expect::value;
+
+	for (std::uint32_t i{0}; i < index.count; ++i) {
+		const std::size_t position = positions[i];
+		const char c = text[position];
+
+		switch (state) {
+		case expect::key_or_close:
+			if (c == '}')
+				break;
+			[[fallthrough]];
+		case expect::key:
+			if (c != '"') [[unlikely]]
+				return detail::fail(json::error::unexpected_character, position);
+			if (auto checked = detail::check_key(index, i); !checked.has_value()) [[unlikely]]
+				return checked;
+			state = expect::colon;
+			continue;
+		case expect::value_or_close:
+			if (c == ']')
+				break;
+			[[fallthrough]];
+		case expect::value:
+			if (c == '{' || c == '[') {
+				open.push_back(i);
+				in_object = c == '{';
+				state = in_object ? expect::key_or_close : expect::value_or_close;
+				continue;
+			}
+			if (c == 't' || c == 'f' || c == 'n') {
+				if (!detail::is_literal(
+						index.text,
+						position,
+						c == 't' ? "true" : c == 'f' ? "false" : "null")) [[unlikely]]
+					return detail::fail(json::error::invalid_literal, position);
+			} else if (c != '"' && c != '-' && !u::detail::parse_helpers::is_digit(c)) [[unlikely]]
+				return detail::fail(json::error::unexpected_character, position);
+			next[i] = i + 1;
+			state = open.empty() ? expect::end : expect::comma_or_close;
+			continue;
+		case expect::colon:
+			if (c != ':') [[unlikely]]
+				return detail::fail(json::error::unexpected_character, position);
+			state = expect::value;
+			continue;
+		case expect::comma_or_close:
+			if (c == ',') {
+				state = in_object ? expect::key : expect::value;
+				continue;
+			}
+			if (c != (in_object ? '}' : ']')) [[unlikely]]
+				return detail::fail(json::error::unexpected_character, position);
+			break;
+		case expect::end:
+			return detail::fail(json::error::unexpected_character, position);
+		}
+
+		// Closes the innermost object or array.
+		next[open.back()] = i + 1;
+		open.pop_back();
+		if (open.empty()) {
+			state = expect::end;
+		} else {
+			in_object = text[positions[open.back()]] == '{';
+			state = expect::comma_or_close;
+		}
+	}
+
+	if (state != expect::end)
+		return detail::fail(json::error::unexpected_end, index.text.size());
+	return {};
+}
+
+// The length of the number at the start of `text` in the grammar of JSON,
+// which is stricter than that of `u::parse`, or zero if there is none.
+[[nodiscard]]
+constexpr std::size_t number_length(std::string_view text, bool& is_integer) noexcept
+{
+	std::size_t i{0};
+	const auto digits = [&] {
+		const std::size_t first = i;
+		while (i < text.size() && u::detail::parse_helpers::is_digit(text[i]))
+			++i;
+		return i - first;
+	};
+
+	i += i < text.size() && text[i] == '-';
+	if (i < text.size() && text[i] == '0')
+		++i;
+	else if (digits() == 0)
+		return 0;
+
+	is_integer = true;
+	if (i < text.size() && text[i] == '.') {
+		++i;
+		is_integer = false;
+		if (digits() == 0)
+			return 0;
+	}
+	if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+		++i;
+		is_integer = false;
+		i += i < text.size() && (text[i] == '+' || text[i] == '-');
+		if (digits() == 0)
+			return 0;
+	}
+	return i;
+}
+
+// Appends the UTF-8 encoding of `code_point`.
+inline void append_utf8(std::string& text, std::uint32_t code_point)
+{
+	if (code_point < 0x80) {
+		text += static_cast<char>(code_point);
+	} else if (code_point < 0x800) {
+		text += static_cast<char>(0xC0 | code_point >> 6);
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	} else if (code_point < 0x10000) {
+		text += static_cast<char>(0xE0 | code_point >> 12);
+		text += static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	} else {
+		text += static_cast<char>(0xF0 | code_point >> 18);
+		text += static_cast<char>(0x80 | (code_point >> 12 & 0x3F));
+		text += static_cast<char>(0x80 | (code_point >> 6 & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+}
+
+[[nodiscard]]
+inline bool parse_hex(std::string_view text, std::size_t at, std::uint32_t& value) noexcept
+{
+	if (text.size() - at < 4)
+		return false;
+	value = 0;
+	for (std::size_t i{at}; i < at + 4; ++i) {
+		const char c = text[i];
+		const std::uint32_t digit =
+			c >= '0' && c <= '9' ? static_cast<std::uint32_t>(c - '0')
+			: c >= 'a' && c <= 'f' ? static_cast<std::uint32_t>(c - 'a' + 10)
+			: c >= 'A' && c <= 'F' ? static_cast<std::uint32_t>(c - 'A' + 10)
+			: 16;
+		if (digit == 16)
+			return false;
+		value = value << 4 | digit;
+	}
+	return true;
+}
+
+// Undoes the escapes of the string `text`, which is written at `base` in the
+// input, and checks that it holds no control character.
+inline json::result<std::string> unescape(std::string_view text, std::size_t base)
+{
+	const auto invalid = [&](std::size_t at) {
+		return detail::fail(json::error::invalid_string, base + at);
+	};
+
+	std::string unescaped;
+	unescaped.reserve(text.size());
+	for (std::size_t i{0}; i < text.size(); ++i) {
+		if (static_cast<unsigned char>(text[i]) < 0x20)
+			return invalid(i);
+		if (text[i] != '\\') {
+			unescaped += text[i];
+			continue;
+		}
+
+		switch (text[++i]) {
+		case '"': unescaped += '"'; break;
+		case '\\': unescaped += '\\'; break;
+		case '/': unescaped += '/'; break;
+		case 'b': unescaped += '\b'; break;
+		case 'f': unescaped += '\f'; break;
+		case 'n': unescaped += '\n'; break;
+		case 'r': unescaped += '\r'; break;
+		case 't': unescaped += '\t'; break;
+		case 'u': {
+			std::uint32_t code_point;
+			if (!detail::parse_hex(text, i + 1, code_point))
+				return invalid(i - 1);
+			i += 4;
+			if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+				// A high surrogate must be followed by a low one.
+				std::uint32_t low;
+				if (text.substr(i + 1, 2) != "\\u"
+						|| !detail::parse_hex(text, i + 3, low)
+						|| low < 0xDC00 || low > 0xDFFF)
+					return invalid(i - 5);
+				code_point = 0x10000
+					+ ((code_point - 0xD800) << 10)
+					+ (low - 0xDC00);
+				i += 6;
+			} else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+				return invalid(i - 5);
+			detail::append_utf8(unescaped, code_point);
+			break;
+		}
+		default:
+			return invalid(i - 1);
+		}
+	}
+	return unescaped;
+}
+
+}  // namespace detail
+
+class value;
+
+// The fields of an object in the order they are written.
+class object_range
+{
+public:
+	class iterator;
+
+	object_range(const detail::index* index, std::uint32_t open) noexcept
+		: m_index{index},
+		  m_open{open}
+	{}
+
+	[[nodiscard]]
+	iterator begin() const noexcept;
+
+	[[nodiscard]]
+	std::default_sentinel_t end() const noexcept
+	{ return {}; }
+
+private:
+	const detail::index* m_index;
+	std::uint32_t m_open;
+};
+
+// The elements of an array in order.
+class array_range
+{
+public:
+	class iterator;
+
+	array_range(const detail::index* index, std::uint32_t open) noexcept
+		: m_index{index},
+		  m_open{open}
+	{}
+
+	[[nodiscard]]
+	iterator begin() const noexcept;
+
+	[[nodiscard]]
+	std::default_sentinel_t end() const noexcept
+	{ return {}; }
+
+private:
+	const detail::index* m_index;
+	std::uint32_t m_open;
+};
+
+// A value in a document, which refers to the document and to its text.
+class value
+{
+public:
+	value(const detail::index* index, std::uint32_t structural) noexcept
+		: m_index{index},
+		  m_structural{structural}
+	{}
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	json::kind kind() const noexcept
+	{
+		switch (this->m_index->at(this->m_structural)) {
+		case '{':
+			return json::kind::object;
+		case '[':
+			return json::kind::array;
+		case '"':
+			return json::kind::string;
+		case 't':
+		case 'f':
+			return json::kind::boolean;
+		case 'n':
+			return json::kind::null;
+		default:
+			return json::kind::number;
+		}
+	}
+
+	[[nodiscard]]
+	bool is_null() const noexcept
+	{ return this->kind() == json::kind::null; }
+
+	// The offset of the value in the text.
+	[[nodiscard]]
+	std::size_t offset() const noexcept
+	{ return this->m_index->positions[this->m_structural]; }
+
+	// Reads the value as a number, a boolean, or a string. A
+	// `std::string_view` is the string as it is written, with its escapes,
+	// and a `std::string` is the string with its escapes undone.
+	template<typename T>
+		requires u::parsable_integer<T>
+			|| u::parsable_floating_point<T>
+			|| std::is_same_v<T, bool>
+			|| std::is_same_v<T, std::string_view>
+			|| std::is_same_v<T, std::string>
+	[[nodiscard]]
+	json::result<T> get() const
+	{
+		if constexpr (std::is_same_v<T, bool>) {
+			if (this->kind() != json::kind::boolean)
+				return this->m_fail(json::error::incorrect_type);
+			return this->m_index->at(this->m_structural) == 't';
+		} else if constexpr (std::is_same_v<T, std::string_view>) {
+			return this->m_raw_string();
+		} else if constexpr (std::is_same_v<T, std::string>) {
+			return this->m_unescaped_string();
+		} else {
+			return this->m_number<T>();
+		}
+	}
+
+	// Finds the field named `key`, compared with the name as it is
+	// written. Fields before it are skipped, and their values not read.
+	[[nodiscard]]
+	json::result<value> operator[](std::string_view key) const
+	{
+		if (this->kind() != json::kind::object)
+			return this->m_fail(json::error::incorrect_type);
+
+		const std::string_view text = this->m_index->text;
+		std::uint32_t at = this->m_structural + 1;
+		while (this->m_index->at(at) == '"') {
+			const std::size_t name = this->m_index->positions[at] + 1;
+			const std::size_t end = name + key.size();
+			const std::size_t colon = this->m_index->positions[at + 1];
+			// The quote after the key only closes the name when nothing but
+			// whitespace follows it up to the colon; otherwise it is an
+			// escaped quote inside a longer name.
+			if (end < colon
+					&& text[end] == '"'
+					&& text.substr(name, key.size()) == key
+					&& value::m_is_blank(text.substr(end + 1, colon - end - 1)))
+				return value{this->m_index, at + 2};
+			const std::uint32_t after = this->m_index->next[at + 2];
+			at = after + (this->m_index->at(after) == ',');
+		}
+		return this->m_fail(json::error::no_such_field);
+	}
+
+	// Finds the element at `position`, skipping those before it.
+	[[nodiscard]]
+	json::result<value> operator[](std::size_t position) const
+	{
+		if (this->kind() != json::kind::array)
+			return this->m_fail(json::error::incorrect_type);
+
+		std::uint32_t at = this->m_structural + 1;
+		for (std::size_t i{0}; this->m_index->at(at) != ']'; ++i) {
+			if (i == position)
+				return value{this->m_index, at};
+			const std::uint32_t after = this->m_index->next[at];
+			at = after + (this->m_index->at(after) == ',');
+		}
+		return this->m_fail(json::error::index_out_of_range);
+	}
+
+	[[nodiscard]]
+	json::result<object_range> fields() const
+	{
+		if (this->kind() != json::kind::object)
+			return this->m_fail(json::error::incorrect_type);
+		return object_range{this->m_index, this->m_structural};
+	}
+
+	[[nodiscard]]
+	json::result<array_range> elements() const
+	{
+		if (this->kind() != json::kind::array)
+			return this->m_fail(json::error::incorrect_type);
+		return array_range{this->m_index, this->m_structural};
+	}
+
+private:
+	const detail::index* m_index;
+	std::uint32_t m_structural;
+
+	[[nodiscard]]
+	u::error<u::located<json::error>> m_fail(json::error error) const noexcept
+	{ return detail::fail(error, this->offset()); }
+
+	template<typename T>
+	[[nodiscard]]
+	json::result<T> m_number() const
+	{
+		if (this->kind() != json::kind::number)
+			return this->m_fail(json::error::incorrect_type);
+
+		const std::string_view text = this->m_index->text.substr(this->offset());
+		bool is_integer{false};
+		const std::size_t length = detail::number_length(text, is_integer);
+		if (length == 0
+				|| (length != text.size()
+					&& !detail::is_whitespace(text[length])
+					&& !detail::is_operator(text[length])))
+			return this->m_fail(json::error::invalid_number);
+		if constexpr (u::parsable_integer<T>)
+			if (!is_integer)
+				return this->m_fail(json::error::incorrect_type);
+
+		const auto parsed = u::parse<T>(text.substr(0, length));
+		if (!parsed.has_value())
+			return this->m_fail(parsed.error() == u::parse_error::invalid_argument
+				? json::error::invalid_number
+				: json::error::number_out_of_range);
+		return parsed->value;
+	}
+
+	[[nodiscard]]
+	json::result<std::string_view> m_raw_string() const
+	{
+		if (this->kind() != json::kind::string)
+			return this->m_fail(json::error::incorrect_type);
+
+		// The first pass found the closing quote, but only kept the
+		// opening one.
+		const std::string_view text = this->m_index->text;
+		const std::size_t first = this->offset() + 1;
+		std::size_t last = first;
+		for (;; ++last) {
+			last = text.find_first_of("\"\\", last);
+			if (text[last] == '"')
+				break;
+			++last;
+		}
+		return text.substr(first, last - first);
+	}
+
+	[[nodiscard]]
+	static constexpr bool m_is_blank(std::string_view text) noexcept
+	{
+		for (const char c : text)
+			if (!detail::is_whitespace(c))
+				return false;
+		return true;
+	}
+
+	[[nodiscard]]
+	json::result<std::string> m_unescaped_string() const
+	{
+		const auto raw = this->m_raw_string();
+		if (!raw.has_value())
+			return u::error<u::located<json::error>>{raw.error()};
+		return detail::unescape(*raw, this->offset() + 1);
+	}
+};
+
+// A field of an object: its name as it is written, and its value.
+struct field
+{
+	std::string_view key;
+	json::value value;
+
+	// The name with its escapes undone. `document::parse` checked them.
+	[[nodiscard]]
+	std::string unescaped_key() const
+	{ return *detail::unescape(this->key, 0); }
+};
+
+class object_range::iterator
+{
+public:
+	using value_type = json::field;
+	using difference_type = std::ptrdiff_t;
+
+	iterator() = default;
+
+	iterator(const detail::index* index, std::uint32_t at) noexcept
+		: m_index{index},
+		  m_at{at}
+	{}
+
+	[[nodiscard]]
+	json::field operator*() const noexcept
+	{
+		const std::size_t name = this->m_index->positions[this->m_at] + 1;
+		const std::size_t length =
+			this->m_index->positions[this->m_at + 1] - name;
+		// The name ends at the last quote before the colon.
+		std::string_view key = this->m_index->text.substr(name, length);
+		key = key.substr(0, key.rfind('"'));
+		return json::field{key, json::value{this->m_index, this->m_at + 2}};
+	}
+
+	iterator& operator++() noexcept
+	{
+		const std::uint32_t after = this->m_index->next[this->m_at + 2];
+		this->m_at = after + (this->m_index->at(after) == ',');
+		return *this;
+	}
+
+	iterator operator++(int) noexcept
+	{
+		iterator previous = *this;
+		++*this;
+		return previous;
+	}
+
+	[[nodiscard]]
+	friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+	{ return it.m_index->at(it.m_at) == '}'; }
+
+private:
+	const detail::index* m_index{nullptr};
+	std::uint32_t m_at{0};
+};
+
+class array_range::iterator
+{
+public:
+	using value_type = json::value;
+	using difference_type = std::ptrdiff_t;
+
+	iterator() = default;
+
+	iterator(const detail::index* index, std::uint32_t at) noexcept
+		: m_index{index},
+		  m_at{at}
+	{}
+
+	[[nodiscard]]
+	json::value operator*() const noexcept
+	{ return json::value{this->m_index, this->m_at}; }
+
+	iterator& operator++() noexcept
+	{
+		const std::uint32_t after = this->m_index->next[this->m_at];
+		this->m_at = after + (this->m_index->at(after) == ',');
+		return *this;
+	}
+
+	iterator operator++(int) noexcept
+	{
+		iterator previous = *this;
+		++*this;
+		return previous;
+	}
+
+	[[nodiscard]]
+	friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept
+	{ return it.m_index->at(it.m_at) == ']'; }
+
+private:
+	const detail::index* m_index{nullptr};
+	std::uint32_t m_at{0};
+};
+
+inline object_range::iterator object_range::begin() const noexcept
+{ return iterator{this->m_index, this->m_open + 1}; }
+
+inline array_range::iterator array_range::begin() const noexcept
+{ return iterator{this->m_index, this->m_open + 1}; }
+
+// A parsed document, which refers to its text. Values refer to the
+// document and stay valid while it lives, even if it is moved.
+class document
+{
+public:
+	// Validates the UTF-8 and the structure of `text` and indexes it.
+	[[nodiscard]]
+	static json::result<document> parse(std::string_view text)
+	{
+		if (text.size() >= std::numeric_limits<std::uint32_t>::max())
+			return detail::fail(json::error::too_large, 0);
+
+		const auto valid = u::validate_utf8(text);
+		if (!valid.has_value())
+			return detail::fail(json::error::invalid_utf8, valid.error().offset);
+
+		auto index = std::make_unique<detail::index>();
+		index->text = text;
+		if (auto found = detail::find_structurals(*index); !found.has_value())
+			return u::error<u::located<json::error>>{found.error()};
+		if (auto checked = detail::check_structure(*index); !checked.has_value())
+			return u::error<u::located<json::error>>{checked.error()};
+		return document{std::move(index)};
+	}
+
+	[[nodiscard]]
+	json::value root() const noexcept
+	{ return json::value{this->m_index.get(), 0}; }
+
+	[[nodiscard]]
+	std::string_view text() const noexcept
+	{ return this->m_index->text; }
+
+private:
+	explicit document(std::unique_ptr<detail::index> index) noexcept
+		: m_index{std::move(index)}
+	{}
+
+	std::unique_ptr<detail::index> m_index;
+};
+
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#include <u/mapped_file.h>
+
+#include <cerrno>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace u
+{
+
+namespace
+{
+
+std::error_code last_error() noexcept
+{ return std::error_code{errno, std::system_category()}; }
+
+std::size_t page_size() noexcept
+{
+	static const std::size_t size = static_cast<std::size_t>(
+		::sysconf(_SC_PAGESIZE));
+	return size;
+}
+
+}
+
+u::result<mapped_file, std::error_code> mapped_file::open(
+	const char* path,
+	map_options options) noexcept
+{
+	const int descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (descriptor == -1)
+		return u::error<std::error_code>{last_error()};
+
+	struct ::stat status;
+	if (::fstat(descriptor, &status) == -1) {
+		const auto error = last_error();
+		::close(descriptor);
+		return u::error<std::error_code>{error};
+	}
+
+	// An empty mapping cannot be made, and needs none.
+	const auto size = static_cast<std::size_t>(status.st_size);
+	if (size == 0) {
+		::close(descriptor);
+		return mapped_file{};
+	}
+
+	int flags = MAP_PRIVATE;
+#if defined MAP_POPULATE
+	if (options.populate)
+		flags |= MAP_POPULATE;
+#endif
+
+	void* const data = ::mmap(nullptr, size, PROT_READ, flags, descriptor, 0);
+	if (data == MAP_FAILED) {
+		const auto error = last_error();
+		::close(descriptor);
+		return u::error<std::error_code>{error};
+	}
+	// The mapping keeps its own reference to the file.
+	::close(descriptor);
+
+	// These are hints, and the mapping works the same if they are refused.
+	if (options.sequential)
+		::madvise(data, size, MADV_SEQUENTIAL);
+#if defined MADV_HUGEPAGE
+	if (options.huge_pages)
+		::madvise(data, size, MADV_HUGEPAGE);
+#endif
+
+	return mapped_file{static_cast<const char*>(data), size};
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+	: m_data{std::exchange(other.m_data, nullptr)},
+	  m_size{std::exchange(other.m_size, 0)}
+{}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+	std::swap(this->m_data, other.m_data);
+	std::swap(this->m_size, other.m_size);
+	return *this;
+}
+
+mapped_file::~mapped_file()
+{
+	if (this->m_data != nullptr)
+		::munmap(const_cast<char*>(this->m_data), this->m_size);
+}
+
+void mapped_file::release(std::size_t offset) noexcept
+{
+	if (offset > this->m_size)
+		offset = this->m_size;
+	const std::size_t length = offset - offset % page_size();
+	if (length != 0)
+		::madvise(const_cast<char*>(this->m_data), length, MADV_DONTNEED);
+}
+
+}
@@ -0,0 +1,99 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_MAPPED_FILE_H
+
+#include <u/config.h>
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include <u/diagnostics/result.h>
+
+namespace u
+{
+
+// How a mapping is going to be read, passed on to the kernel as hints.
+struct map_options
+{
+	// Reads ahead aggressively and lets pages go soon after they were read.
+	bool sequential{true};
+	// Backs the mapping with huge pages where the file system supports it.
+	bool huge_pages{true};
+	// Faults the whole file in before `open` returns.
+	bool populate{false};
+};
+
+// A whole file mapped read-only into memory. The pages are those of the page
+// cache, so reading the file neither copies it nor counts it twice in the
+// resident set, and views into it stay valid while the mapping lives.
+class mapped_file
+{
+public:
+	// Maps the file at `path`, or fails with the error of the system call
+	// which failed.
+	[[nodiscard]]
+	static u::result<mapped_file, std::error_code> open(
+		const char* path,
+		map_options options = {}) noexcept;
+
+	constexpr mapped_file() noexcept = default;
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	mapped_file(mapped_file&& other) noexcept;
+	mapped_file& operator=(mapped_file&& other) noexcept;
+
+	~mapped_file();
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	constexpr const char* data() const noexcept
+	{ return this->m_data; }
+
+	[[nodiscard]]
+	constexpr std::size_t size() const noexcept
+	{ return this->m_size; }
+
+	[[nodiscard]]
+	constexpr bool empty() const noexcept
+	{ return this->m_size == 0; }
+
+	[[nodiscard]]
+	constexpr std::string_view view() const noexcept
+	{ return std::string_view{this->m_data, this->m_size}; }
+
+	[[nodiscard]]
+	std::span<const std::byte> bytes() const noexcept
+	{
+		return std::span<const std::byte>{
+			reinterpret_cast<const std::byte*>(this->m_data),
+			this->m_size};
+	}
+
+	//
+	// Modifiers
+	//
+
+	// Drops the pages which lie wholly before `offset` from the resident
+	// set. They are read again from the page cache if they are touched.
+	void release(std::size_t offset) noexcept;
+
+private:
+	constexpr mapped_file(const char* data, std::size_t size) noexcept
+		: m_data{data},
+		  m_size{size}
+	{}
+
+	const char* m_data{nullptr};
+	std::size_t m_size{0};
+};
+
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_NICHE_H
+
+#include <memory>
+#include <type_traits>
+
+namespace u
+{
+
+// A niche is a bit pattern of `T` that never represents a valid `T`.
+// Types opt in by specializing `niche_traits` with:
+//
+//	static constexpr void construct_niche(T* storage) noexcept;
+//	static constexpr bool is_niche(const T* storage) noexcept;
+//
+// `construct_niche` writes the niche into uninitialized storage and
+// `is_niche` inspects the object representation; neither may read the
+// storage as a `T` when it holds the niche. `bool` has no niche, since no
+// byte other than 0 and 1 can be stored in one in a constant expression.
+template<typename T>
+struct niche_traits
+{};
+
+template<typename T>
+concept has_niche =
+	std::is_trivially_copyable_v<T>
+	&& requires (T* storage, const T* const_storage) {
+		{ u::niche_traits<T>::construct_niche(storage) } noexcept;
+		{ u::niche_traits<T>::is_niche(const_storage) } noexcept
+			-> std::same_as<bool>;
+	};
+
+template<typename T>
+constexpr bool has_niche_v = u::has_niche<T>;
+
+// Enumerations opt in by naming a value no enumerator uses:
+//
+//	template<>
+//	struct u::niche_traits<color>
+//		: u::enum_niche_traits<color, static_cast<color>(0xFF)>
+//	{};
+template<typename T, T Niche>
+	requires std::is_enum_v<T>
+struct enum_niche_traits
+{
+	static constexpr void construct_niche(T* storage) noexcept
+	{ std::construct_at(storage, Niche); }
+
+	[[nodiscard]]
+	static constexpr bool is_niche(const T* storage) noexcept
+	{ return *storage == Niche; }
+};
+
+namespace detail::niche_helpers
+{
+
+// Storage for a `T` in which no `T` is ever made, so that its address is
+// never that of an object of the program.
+template<typename T>
+union pointer_niche
+{
+	char none{};
+	T object;
+
+	~pointer_niche() requires std::is_trivially_destructible_v<T> = default;
+	~pointer_niche() {}
+};
+
+// The storage comes after a leading byte, so that its address is inside an
+// object and cannot also be the end of the object before it. It reserves
+// a little more than a `T` in zero-initialized data, once per pointee type.
+template<typename T>
+struct pointer_niche_holder
+{
+	char guard{};
+	pointer_niche<T> storage{};
+};
+
+template<typename T>
+constinit pointer_niche_holder<std::remove_cv_t<T>> pointer_niche_object{};
+
+}  // namespace detail::niche_helpers
+
+// The address of storage which never holds a `T` is a niche of `T*`, and
+// null stays a valid value. Unlike a misaligned address, it can be made and
+// compared in constant expressions.
+template<typename T>
+	requires std::is_object_v<T>
+		&& requires { sizeof(T); }
+		&& (!std::is_abstract_v<T>)
+struct niche_traits<T*>
+{
+	static constexpr void construct_niche(T** storage) noexcept
+	{
+		std::construct_at(
+			storage,
+			&detail::niche_helpers::pointer_niche_object<T>.storage.object);
+	}
+
+	[[nodiscard]]
+	static constexpr bool is_niche(T* const* storage) noexcept
+	{ return *storage == &detail::niche_helpers::pointer_niche_object<T>.storage.object; }
+};
+
+}
@@ -4,13 +4,719 @@
 #pragma once
 #define U_INCLUDED_PARSING_H
 
+#include <u/config.h>
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if defined __SSE2__
+#	include <immintrin.h>
+#endif
+
 #include <u/diagnostics/result.h>
+#include <u/powers_of_five.h>
 
 namespace u
 {
 
-template<typename T, typename E>
-u::result<T, E> parse() noexcept;
+enum class parse_error : std::uint8_t
+{
+	// The input does not start with a number.
+	invalid_argument = 1,
+	// The number does not fit in the type it is parsed as.
+	out_of_range,
+	// The number is not zero but too small for the type it is parsed as.
+	underflow
+};
+
+// A parsed value and the number of characters it was parsed from.
+template<typename T>
+struct parsed
+{
+	T value;
+	std::size_t length;
+};
+
+template<typename T>
+concept parsable_integer =
+	std::is_integral_v<T>
+	&& !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+template<typename T>
+concept parsable_floating_point =
+	std::is_same_v<T, float>
+	|| std::is_same_v<T, double>;
+
+namespace detail::parse_helpers
+{
+
+struct digits
+{
+	std::uint64_t value;
+	std::size_t length;
+	bool overflow;
+};
+
+[[nodiscard]]
+constexpr bool is_digit(char c) noexcept
+{ return static_cast<unsigned char>(c - '0') < 10; }
+
+[[nodiscard]]
+constexpr std::uint64_t load_eight(const char* first) noexcept
+{
+	if (std::is_constant_evaluated()) {
+		std::uint64_t word{0};
+		for (int i{7}; i >= 0; --i)
+			word = word << 8 | static_cast<unsigned char>(first[i]);
+		return word;
+	}
+	std::uint64_t word;
+	std::memcpy(&word, first, sizeof(word));
+	return word;
+}
+
+// The number of ASCII digits at the start of `word`, the first in the lowest
+// byte.
+[[nodiscard]]
+constexpr std::size_t count_digits(std::uint64_t word) noexcept
+{
+	const std::uint64_t others = ((word & 0xF0F0F0F0F0F0F0F0)
+		| (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+		^ 0x3333333333333333;
+	return static_cast<std::size_t>(std::countr_zero(others)) / 8;
+}
+
+// Converts eight decimal digits, the first in the lowest byte, in three
+// multiplications.
+[[nodiscard]]
+constexpr std::uint32_t convert_eight(std::uint64_t word) noexcept
+{
+	word = word * 10 + (word >> 8);
+	return static_cast<std::uint32_t>(
+		((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))
+			+ ((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))
+		>> 32);
+}
+
+inline constexpr std::array<std::uint64_t, 9> powers_of_ten{
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+// Appends `count` digits worth `value` to `digits`. Nineteen digits always
+// fit in 64 bits, so only longer numbers are checked for overflow.
+constexpr void append(digits& digits, std::uint64_t value, std::size_t count)
+noexcept
+{
+	const std::uint64_t scale = parse_helpers::powers_of_ten[count];
+	if (digits.length + count <= 19) [[likely]] {
+		digits.value = digits.value * scale + value;
+	} else {
+		digits.overflow |= __builtin_mul_overflow(
+			digits.value,
+			scale,
+			&digits.value);
+		digits.overflow |= __builtin_add_overflow(
+			digits.value,
+			value,
+			&digits.value);
+	}
+	digits.length += count;
+}
+
+// Parses eight bytes at a time with SWAR arithmetic and the last few one at
+// a time.
+[[nodiscard]]
+constexpr digits parse_scalar(
+	const char* first,
+	const char* last,
+	digits      digits) noexcept
+{
+	for (; last - first >= 8; first += 8) {
+		const std::uint64_t word = parse_helpers::load_eight(first);
+		const std::size_t count = parse_helpers::count_digits(word);
+		if (count == 0)
+			return digits;
+
+		// Shifts the digits to the top so that the bytes below read as zeros.
+		const std::uint64_t values =
+			(word - 0x3030303030303030) << (8 * (8 - count));
+		parse_helpers::append(
+			digits,
+			parse_helpers::convert_eight(values),
+			count);
+		if (count < 8)
+			return digits;
+	}
+	for (; first != last && parse_helpers::is_digit(*first); ++first)
+		parse_helpers::append(
+			digits,
+			static_cast<std::uint64_t>(*first - '0'),
+			1);
+	return digits;
+}
+
+#if defined __SSE4_1__
+
+// For each count of leading digits, the shuffle which moves them to the top
+// of a vector and zeroes the lanes below.
+inline constexpr auto alignments = [] {
+	std::array<std::array<std::int8_t, 16>, 17> alignments{};
+	for (std::size_t length{0}; length <= 16; ++length)
+		for (std::size_t lane{0}; lane < 16; ++lane)
+			alignments[length][lane] = lane < 16 - length
+				? std::int8_t{-128}
+				: static_cast<std::int8_t>(lane - (16 - length));
+	return alignments;
+}();
+
+// Parses the digits at the start of 16 readable bytes at once.
+[[nodiscard]]
+inline digits parse_sixteen(const char* first) noexcept
+{
+	const __m128i values = _mm_sub_epi8(
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(first)),
+		_mm_set1_epi8('0'));
+	const __m128i are_digits = _mm_cmpeq_epi8(
+		_mm_subs_epu8(values, _mm_set1_epi8(9)),
+		_mm_setzero_si128());
+	const std::size_t length = static_cast<std::size_t>(std::countr_one(
+		static_cast<std::uint32_t>(_mm_movemask_epi8(are_digits))));
+
+	const __m128i aligned = _mm_shuffle_epi8(
+		values,
+		_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+			alignments[length].data())));
+	const __m128i pairs = _mm_maddubs_epi16(
+		aligned,
+		_mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+	const __m128i quads = _mm_madd_epi16(
+		pairs,
+		_mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	const __m128i eights = _mm_madd_epi16(
+		_mm_packus_epi32(quads, quads),
+		_mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+	const auto high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(eights));
+	const auto low = static_cast<std::uint32_t>(_mm_extract_epi32(eights, 1));
+	return {std::uint64_t{high} * 100000000 + low, length, false};
+}
+
+#endif
+
+// Parses the decimal digits at the start of `[first, last)`, sixteen at once
+// when SSE4.1 is enabled and that many bytes are left.
+[[nodiscard]]
+constexpr digits parse_digits(const char* first, const char* last) noexcept
+{
+#if defined __SSE4_1__
+	if (!std::is_constant_evaluated() && last - first >= 16) {
+		const digits digits = parse_helpers::parse_sixteen(first);
+		if (digits.length < 16)
+			return digits;
+		return parse_helpers::parse_scalar(first + 16, last, digits);
+	}
+#endif
+	return parse_helpers::parse_scalar(first, last, digits{});
+}
+
+// Converts the digits of an integer, preceded by a minus sign if `negative`,
+// to `T`.
+template<typename T>
+[[nodiscard]]
+constexpr u::result<T, u::parse_error> to_integer(
+	const digits& digits,
+	bool          negative) noexcept
+{
+	using unsigned_type = std::make_unsigned_t<T>;
+
+	if (digits.length == 0)
+		return u::error{u::parse_error::invalid_argument};
+
+	const std::uint64_t limit =
+		std::uint64_t{static_cast<unsigned_type>(std::numeric_limits<T>::max())}
+		+ negative;
+	if (digits.overflow || digits.value > limit) [[unlikely]]
+		return u::error{u::parse_error::out_of_range};
+
+	const auto magnitude = static_cast<unsigned_type>(digits.value);
+	return static_cast<T>(negative
+		? static_cast<unsigned_type>(unsigned_type{0} - magnitude)
+		: magnitude);
+}
+
+template<typename T>
+struct binary_format;
+
+template<>
+struct binary_format<float>
+{
+	using bits_type = std::uint32_t;
+
+	static constexpr int mantissa_bits{23};
+	static constexpr int minimum_exponent{-127};
+	static constexpr int infinite_power{0xFF};
+	static constexpr int smallest_power_of_ten{-65};
+	static constexpr int largest_power_of_ten{38};
+	static constexpr int min_exponent_round_to_even{-17};
+	static constexpr int max_exponent_round_to_even{10};
+	static constexpr std::array<float, 11> exact_powers_of_ten{
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+template<>
+struct binary_format<double>
+{
+	using bits_type = std::uint64_t;
+
+	static constexpr int mantissa_bits{52};
+	static constexpr int minimum_exponent{-1023};
+	static constexpr int infinite_power{0x7FF};
+	static constexpr int smallest_power_of_ten{-342};
+	static constexpr int largest_power_of_ten{308};
+	static constexpr int min_exponent_round_to_even{-4};
+	static constexpr int max_exponent_round_to_even{23};
+	static constexpr std::array<double, 23> exact_powers_of_ten{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+// A decimal number `mantissa * 10^exponent`, of which at most the first 19
+// significant digits are kept.
+struct decimal
+{
+	std::uint64_t mantissa;
+	std::int64_t exponent;
+	std::size_t length;
+	bool negative;
+	bool truncated;
+};
+
+[[nodiscard]]
+constexpr bool starts_with_word(
+	const char*      first,
+	const char*      last,
+	std::string_view word) noexcept
+{
+	if (static_cast<std::size_t>(last - first) < word.size())
+		return false;
+	for (const char c : word)
+		if ((*first++ | 0x20) != c)
+			return false;
+	return true;
+}
+
+// Scans a number in the general format of `std::from_chars`. A length of
+// zero means there was none.
+[[nodiscard]]
+constexpr decimal scan_decimal(const char* const start, const char* last)
+noexcept
+{
+	decimal decimal{};
+	const char* first = start;
+	if (first != last && *first == '-') {
+		decimal.negative = true;
+		++first;
+	}
+
+	std::size_t significant{0};
+	bool any_digit{false};
+	const auto take = [&](char c, bool fractional) {
+		const auto digit = static_cast<std::uint64_t>(c - '0');
+		any_digit = true;
+		if (significant == 0 && digit == 0) {
+			decimal.exponent -= fractional;
+		} else if (significant < 19) {
+			decimal.mantissa = decimal.mantissa * 10 + digit;
+			decimal.exponent -= fractional;
+			++significant;
+		} else {
+			decimal.exponent += !fractional;
+			decimal.truncated |= digit != 0;
+		}
+	};
+
+	for (; first != last && parse_helpers::is_digit(*first); ++first)
+		take(*first, false);
+	if (first != last && *first == '.') {
+		const char* const point = first++;
+		for (; first != last && parse_helpers::is_digit(*first); ++first)
+			take(*first, true);
+		if (!any_digit)
+			first = point;
+	}
+	if (!any_digit)
+		return {};
+
+	if (first != last && (*first | 0x20) == 'e') {
+		const char* exponent = first + 1;
+		bool negative{false};
+		if (exponent != last && (*exponent == '-' || *exponent == '+'))
+			negative = *exponent++ == '-';
+		if (exponent != last && parse_helpers::is_digit(*exponent)) {
+			std::int64_t value{0};
+			for (; exponent != last && parse_helpers::is_digit(*exponent);
+				++exponent)
+				if (value < 100000000)
+					value = value * 10 + (*exponent - '0');
+			decimal.exponent += negative ? -value : value;
+			first = exponent;
+		}
+	}
+	decimal.length = static_cast<std::size_t>(first - start);
+	return decimal;
+}
+
+[[nodiscard]]
+constexpr unsigned __int128 multiply(std::uint64_t a, std::uint64_t b) noexcept
+{ return static_cast<unsigned __int128>(a) * b; }
+
+// A binary floating-point number as an exponent field and a mantissa field.
+struct adjusted_mantissa
+{
+	std::uint64_t mantissa;
+	int power;
+
+	constexpr bool operator==(const adjusted_mantissa&) const = default;
+};
+
+// The Eisel-Lemire algorithm: rounds `mantissa * 10^exponent` to the
+// nearest `T` from a 128-bit approximation of the power of five, which is
+// exact whenever `mantissa` holds every significant digit.
+template<typename T>
+[[nodiscard]]
+constexpr adjusted_mantissa compute_float(
+	std::int64_t  exponent,
+	std::uint64_t mantissa) noexcept
+{
+	using format = binary_format<T>;
+
+	if (mantissa == 0 || exponent < format::smallest_power_of_ten)
+		return {0, 0};
+	if (exponent > format::largest_power_of_ten)
+		return {0, format::infinite_power};
+
+	const int zeros = std::countl_zero(mantissa);
+	mantissa <<= zeros;
+
+	const auto index = static_cast<std::size_t>(
+		2 * (exponent - smallest_power_of_five));
+	constexpr std::uint64_t precision_mask =
+		~std::uint64_t{0} >> (format::mantissa_bits + 3);
+	unsigned __int128 product =
+		parse_helpers::multiply(mantissa, powers_of_five[index]);
+	if ((static_cast<std::uint64_t>(product >> 64) & precision_mask)
+		== precision_mask) {
+		product += parse_helpers::multiply(
+			mantissa,
+			powers_of_five[index + 1]) >> 64;
+	}
+	const auto high = static_cast<std::uint64_t>(product >> 64);
+	const auto low = static_cast<std::uint64_t>(product);
+
+	const int upper_bit = static_cast<int>(high >> 63);
+	const int shift = upper_bit + 64 - format::mantissa_bits - 3;
+	adjusted_mantissa result{
+		high >> shift,
+		static_cast<int>(
+			((217706 * static_cast<int>(exponent)) >> 16) + 63
+			+ upper_bit - zeros - format::minimum_exponent)};
+
+	if (result.power <= 0) {
+		if (-result.power + 1 >= 64)
+			return {0, 0};
+		result.mantissa >>= -result.power + 1;
+		result.mantissa += result.mantissa & 1;
+		result.mantissa >>= 1;
+		result.power =
+			result.mantissa < (std::uint64_t{1} << format::mantissa_bits)
+				? 0
+				: 1;
+		return result;
+	}
+
+	// Ties exactly halfway round to even.
+	if (low <= 1
+		&& exponent >= format::min_exponent_round_to_even
+		&& exponent <= format::max_exponent_round_to_even
+		&& (result.mantissa & 3) == 1
+		&& (result.mantissa << shift) == high)
+		result.mantissa &= ~std::uint64_t{1};
+
+	result.mantissa += result.mantissa & 1;
+	result.mantissa >>= 1;
+	if (result.mantissa >= (std::uint64_t{2} << format::mantissa_bits)) {
+		result.mantissa = std::uint64_t{1} << format::mantissa_bits;
+		++result.power;
+	}
+	result.mantissa &= ~(std::uint64_t{1} << format::mantissa_bits);
+	if (result.power >= format::infinite_power)
+		return {0, format::infinite_power};
+	return result;
+}
+
+template<typename T>
+[[nodiscard]]
+constexpr T to_float(adjusted_mantissa binary, bool negative) noexcept
+{
+	using format = binary_format<T>;
+	using bits_type = typename format::bits_type;
+
+	return std::bit_cast<T>(static_cast<bits_type>(
+		binary.mantissa
+		| std::uint64_t(binary.power) << format::mantissa_bits
+		| std::uint64_t{negative} << (sizeof(T) * 8 - 1)));
+}
+
+// Parses "inf", "infinity" and "nan", optionally followed by a parenthesized
+// sequence of letters, digits and underscores, in any case.
+template<typename T>
+[[nodiscard]]
+constexpr u::result<u::parsed<T>, u::parse_error> parse_special(
+	const char* const start,
+	const char*       last) noexcept
+{
+	using format = binary_format<T>;
+
+	const char* first = start;
+	const bool negative = first != last && *first == '-';
+	first += negative;
+
+	if (parse_helpers::starts_with_word(first, last, "inf")) {
+		first += parse_helpers::starts_with_word(first, last, "infinity")
+			? 8
+			: 3;
+		return u::parsed<T>{
+			parse_helpers::to_float<T>({0, format::infinite_power}, negative),
+			static_cast<std::size_t>(first - start)};
+	}
+	if (parse_helpers::starts_with_word(first, last, "nan")) {
+		first += 3;
+		if (first != last && *first == '(') {
+			const char* end = first + 1;
+			while (end != last
+				&& (parse_helpers::is_digit(*end)
+					|| static_cast<unsigned char>((*end | 0x20) - 'a') < 26
+					|| *end == '_'))
+				++end;
+			if (end != last && *end == ')')
+				first = end + 1;
+		}
+		return u::parsed<T>{
+			parse_helpers::to_float<T>(
+				{std::uint64_t{1} << (format::mantissa_bits - 1),
+					format::infinite_power},
+				negative),
+			static_cast<std::size_t>(first - start)};
+	}
+	return u::error{u::parse_error::invalid_argument};
+}
+
+template<typename T>
+[[nodiscard]]
+constexpr u::result<u::parsed<T>, u::parse_error> parse_floating(
+	std::string_view input) noexcept
+{
+	using format = binary_format<T>;
+
+	const char* const first = input.data();
+	const char* const last = first + input.size();
+	const decimal decimal = parse_helpers::scan_decimal(first, last);
+	if (decimal.length == 0)
+		return parse_helpers::parse_special<T>(first, last);
+
+	// Clinger's fast path: both the mantissa and the power of ten are exact,
+	// so one correctly rounded operation gives the correctly rounded result.
+	constexpr auto max_exponent =
+		static_cast<std::int64_t>(format::exact_powers_of_ten.size()) - 1;
+	if (!decimal.truncated
+		&& decimal.exponent >= -max_exponent
+		&& decimal.exponent <= max_exponent
+		&& decimal.mantissa <= std::uint64_t{2} << format::mantissa_bits) {
+		T value = static_cast<T>(decimal.mantissa);
+		if (decimal.exponent < 0)
+			value /= format::exact_powers_of_ten[
+				static_cast<std::size_t>(-decimal.exponent)];
+		else value *= format::exact_powers_of_ten[
+			static_cast<std::size_t>(decimal.exponent)];
+		return u::parsed<T>{decimal.negative ? -value : value, decimal.length};
+	}
+
+	adjusted_mantissa binary = parse_helpers::compute_float<T>(
+		decimal.exponent,
+		decimal.mantissa);
+
+	// The dropped digits put the number between the kept ones and the next
+	// mantissa up; when those round apart, only exact arithmetic can tell.
+	if (decimal.truncated
+		&& binary != parse_helpers::compute_float<T>(
+			decimal.exponent,
+			decimal.mantissa + 1)) {
+		T value{};
+		const auto [end, error] =
+			std::from_chars(first, first + decimal.length, value);
+		if (error == std::errc::result_out_of_range)
+			return u::error{decimal.exponent > 0
+				? u::parse_error::out_of_range
+				: u::parse_error::underflow};
+		return u::parsed<T>{value, decimal.length};
+	}
+
+	if (binary.power == format::infinite_power)
+		return u::error{u::parse_error::out_of_range};
+	if (binary.power == 0 && binary.mantissa == 0 && decimal.mantissa != 0)
+		return u::error{u::parse_error::underflow};
+	return u::parsed<T>{
+		parse_helpers::to_float<T>(binary, decimal.negative),
+		decimal.length};
+}
+
+// The number of line feeds before `offset`, and the offset just after the
+// last of them. Blocks of 64 bytes are compared at once.
+struct line_start
+{
+	std::size_t line;
+	std::size_t offset;
+};
+
+[[nodiscard]]
+constexpr line_start find_line_start(
+	std::string_view input,
+	std::size_t offset) noexcept
+{
+	line_start start{0, 0};
+	std::size_t i{0};
+#if defined __SSE2__
+	if (!std::is_constant_evaluated()) {
+		const __m128i line_feed = _mm_set1_epi8('\n');
+		for (; offset - i >= 64; i += 64) {
+			std::uint64_t line_feeds{0};
+			for (std::size_t k{0}; k < 4; ++k)
+				line_feeds |= std::uint64_t{static_cast<std::uint16_t>(
+					_mm_movemask_epi8(_mm_cmpeq_epi8(
+						_mm_loadu_si128(reinterpret_cast<const __m128i*>(
+							input.data() + i + 16 * k)),
+						line_feed)))} << (16 * k);
+			if (line_feeds != 0) {
+				start.line += static_cast<std::size_t>(std::popcount(line_feeds));
+				start.offset = i + 64
+					- static_cast<std::size_t>(std::countl_zero(line_feeds));
+			}
+		}
+	}
+#endif
+	for (; i < offset; ++i)
+		if (input[i] == '\n')
+			start = line_start{start.line + 1, i + 1};
+	return start;
+}
+
+}  // namespace detail::parse_helpers
+
+// Parses a decimal integer at the start of `input`, preceded by a minus sign
+// when `T` is signed, the way `std::from_chars` does. Parsing stops at the
+// first character that is not a digit; a number too large for `T` fails
+// with `parse_error::out_of_range`.
+template<u::parsable_integer T, typename E = u::parse_error>
+	requires std::is_constructible_v<E, u::parse_error>
+[[nodiscard]]
+constexpr u::result<u::parsed<T>, E> parse(std::string_view input)
+noexcept(std::is_nothrow_constructible_v<E, u::parse_error>)
+{
+	const char* first = input.data();
+	const char* const last = first + input.size();
+
+	bool negative{false};
+	if constexpr (std::is_signed_v<T>) {
+		if (first != last && *first == '-') {
+			negative = true;
+			++first;
+		}
+	}
+
+	const auto digits = detail::parse_helpers::parse_digits(first, last);
+	auto value = detail::parse_helpers::to_integer<T>(digits, negative);
+	if (!value.has_value())
+		return u::error<E>{std::in_place, value.error()};
+	return u::parsed<T>{*value, digits.length + negative};
+}
+
+// Parses a decimal floating-point number at the start of `input`, in the
+// general format of `std::from_chars`, rounded to the nearest `T`. A number
+// too large for `T` fails with `parse_error::out_of_range` and one which
+// is not zero but rounds to zero fails with `parse_error::underflow`.
+//
+// Numbers with more than 19 significant digits that lie too close to a
+// halfway point for the fast algorithm go through `std::from_chars`, and
+// are not constant expressions.
+template<u::parsable_floating_point T, typename E = u::parse_error>
+	requires std::is_constructible_v<E, u::parse_error>
+[[nodiscard]]
+constexpr u::result<u::parsed<T>, E> parse(std::string_view input)
+noexcept(std::is_nothrow_constructible_v<E, u::parse_error>)
+{
+	auto parsed = detail::parse_helpers::parse_floating<T>(input);
+	if constexpr (std::is_same_v<E, u::parse_error>)
+		return parsed;
+	else {
+		if (!parsed.has_value())
+			return u::error<E>{std::in_place, parsed.error()};
+		return *parsed;
+	}
+}
+
+template<typename T, typename E = u::parse_error>
+	requires (u::parsable_integer<T> || u::parsable_floating_point<T>)
+		&& std::is_constructible_v<E, u::parse_error>
+[[nodiscard]]
+u::result<u::parsed<T>, E> parse(std::span<const std::byte> input)
+noexcept(std::is_nothrow_constructible_v<E, u::parse_error>)
+{
+	return u::parse<T, E>(std::string_view{
+		reinterpret_cast<const char*>(input.data()),
+		input.size()});
+}
+
+// A line and a column in a text, both counted from one. Columns are
+// counted in bytes.
+struct text_location
+{
+	std::size_t line;
+	std::size_t column;
+};
+
+// Finds the line and column of the byte at `offset` in `input`. Parsers
+// keep only offsets, and lines are counted here when an error is reported
+// rather than as the input is parsed.
+[[nodiscard]]
+constexpr u::text_location locate(
+	std::string_view input,
+	std::size_t offset) noexcept
+{
+	if (offset > input.size())
+		offset = input.size();
+	const auto start = detail::parse_helpers::find_line_start(input, offset);
+	return u::text_location{start.line + 1, offset - start.offset + 1};
+}
+
+// An error and the offset of the byte in the input at which it occurred.
+template<typename ErrorType>
+struct located
+{
+	ErrorType error;
+	std::size_t offset;
 
+	// The line and column of the error in `input`, the text it was found
+	// in.
+	[[nodiscard]]
+	constexpr u::text_location location(std::string_view input) const noexcept
+	{ return u::locate(input, this->offset); }
+};
 
 }
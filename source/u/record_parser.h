@@ -0,0 +1,514 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_RECORD_PARSER_H
+
+#include <u/config.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined __SSE2__
+#	include <emmintrin.h>
+#endif
+
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+#include <u/tokenizer.h>
+
+// Parses delimited records, such as CSV or TSV, into typed columns:
+//
+//	auto table = u::parse_records<std::int64_t, double, std::string_view>(
+//		file.view());
+//	for (const u::record_failure& failure : table.failures())
+//		report(failure.row, failure.error.offset);
+//	std::span<const double> prices = table.column<1>();
+//
+// Records end at a line feed, optionally preceded by a carriage return, and
+// fields which are quoted may hold delimiters, line feeds and doubled
+// quotes. A `std::string_view` field refers to the input as it is, without
+// the quotes around it but with quotes inside it still doubled, while a
+// `std::string` field holds the text with the doubled quotes undone.
+
+namespace u
+{
+
+enum class record_error : std::uint8_t
+{
+	// The same as those of `u::parse_error`.
+	invalid_argument = 1,
+	out_of_range,
+	underflow,
+	// The record has fewer fields than there are columns.
+	missing_field,
+	// The record has more fields than there are columns.
+	extra_field,
+	// A quoted field is not closed before the end of the input.
+	unterminated_quote
+};
+
+struct record_format
+{
+	char delimiter{','};
+	char quote{'"'};
+};
+
+// A record which failed to parse, and whose fields are left value
+// initialized in the columns.
+struct record_failure
+{
+	std::size_t row;
+	std::size_t column;
+	u::located<u::record_error> error;
+};
+
+template<typename T>
+concept record_field =
+	u::parsable_integer<T>
+	|| u::parsable_floating_point<T>
+	|| std::is_same_v<T, std::string_view>
+	|| std::is_same_v<T, std::string>;
+
+namespace detail::record_helpers
+{
+
+// Where the parse of a record stopped, with its error.
+struct failure
+{
+	std::size_t column;
+	u::located<u::record_error> error;
+};
+
+// Finds the end of the record which starts at `first`: the first line feed
+// at which an even number of quotes has been seen. Quotes are only counted,
+// the same way `summarize` counts them, so that every chunk agrees on where
+// the records are.
+[[nodiscard]]
+constexpr const char* find_record_end(
+	const char* first,
+	const char* last,
+	char quote) noexcept
+{
+	bool quoted{false};
+	for (;; ++first) {
+		const std::string_view rest{first, last};
+		const char* const line_feed = first + std::min(rest.find('\n'), rest.size());
+		quoted = quoted != (std::count(first, line_feed, quote) % 2 != 0);
+		if (!quoted || line_feed == last)
+			return line_feed;
+		first = line_feed;
+	}
+}
+
+// Copies a quoted field with its doubled quotes undone.
+constexpr void unquote(std::string_view field, char quote, std::string& text)
+{
+	text.clear();
+	text.reserve(field.size());
+	for (std::size_t i{0}; i < field.size(); ++i) {
+		text += field[i];
+		i += field[i] == quote;
+	}
+}
+
+template<typename T>
+[[nodiscard]]
+constexpr std::optional<failure> convert(
+	std::string_view field,
+	bool quoted,
+	char quote,
+	std::size_t column,
+	std::size_t offset,
+	T& value)
+{
+	if constexpr (std::is_same_v<T, std::string_view>) {
+		value = field;
+	} else if constexpr (std::is_same_v<T, std::string>) {
+		if (quoted)
+			record_helpers::unquote(field, quote, value);
+		else value.assign(field);
+	} else {
+		const auto parsed = u::parse<T>(field);
+		if (!parsed.has_value())
+			return failure{column, {
+				static_cast<u::record_error>(parsed.error()),
+				offset}};
+		if (parsed->length != field.size())
+			return failure{column, {
+				u::record_error::invalid_argument,
+				offset + parsed->length}};
+		value = parsed->value;
+	}
+	return std::nullopt;
+}
+
+// Parses the fields of the record which starts at `first` into `values`,
+// and moves `first` to the line feed which ends it, or to `last`. Where it
+// stops is only meaningful when the record parsed. Offsets are counted from
+// `base`.
+//
+// Numbers which are not quoted are parsed straight from the input, and the
+// other fields are scanned once.
+template<typename... Ts>
+[[nodiscard]]
+constexpr std::optional<failure> parse_fields(
+	const char*& first,
+	const char* last,
+	const char* base,
+	u::record_format format,
+	std::tuple<Ts...>& values)
+{
+	std::optional<failure> result;
+	const auto fail = [&](std::size_t column, u::record_error error, const char* at) {
+		result = failure{column, {error, static_cast<std::size_t>(at - base)}};
+		return false;
+	};
+	const auto is_record_end = [&](const char* at) {
+		return at == last
+			|| *at == '\n'
+			|| (*at == '\r' && (last - at == 1 || at[1] == '\n'));
+	};
+
+	const auto field = [&]<std::size_t Index>(
+			std::integral_constant<std::size_t, Index>) {
+		using value_type = std::tuple_element_t<Index, std::tuple<Ts...>>;
+		auto& value = std::get<Index>(values);
+
+		if constexpr (Index != 0) {
+			if (first == last || *first != format.delimiter)
+				return fail(Index, u::record_error::missing_field, first);
+			++first;
+		}
+
+		if (first != last && *first == format.quote) {
+			const char* const start = ++first;
+			for (;; first += 2) {
+				first = std::find(first, last, format.quote);
+				if (first == last)
+					return fail(Index, u::record_error::unterminated_quote, start - 1);
+				if (last - first < 2 || first[1] != format.quote)
+					break;
+			}
+			const std::string_view text{start, first};
+			if (++first; !is_record_end(first) && *first != format.delimiter)
+				return fail(Index, u::record_error::invalid_argument, first);
+			result = record_helpers::convert(
+				text,
+				true,
+				format.quote,
+				Index,
+				static_cast<std::size_t>(start - base),
+				value);
+			return !result.has_value();
+		}
+
+		if constexpr (u::parsable_integer<value_type>
+				|| u::parsable_floating_point<value_type>) {
+			const auto parsed = u::parse<value_type>(std::string_view{first, last});
+			if (!parsed.has_value())
+				return fail(
+					Index,
+					static_cast<u::record_error>(parsed.error()),
+					first);
+			first += parsed->length;
+			value = parsed->value;
+		} else {
+			// A quote inside a field which is not quoted is refused, since
+			// the chunks would disagree on whether it opens a quoted field.
+			const char* const start = first;
+			while (first != last
+					&& *first != format.delimiter
+					&& *first != format.quote
+					&& !is_record_end(first))
+				++first;
+			if (first != last && *first == format.quote)
+				return fail(Index, u::record_error::invalid_argument, first);
+			result = record_helpers::convert(
+				std::string_view{start, first},
+				false,
+				format.quote,
+				Index,
+				static_cast<std::size_t>(start - base),
+				value);
+		}
+		if (!is_record_end(first) && *first != format.delimiter)
+			return fail(Index, u::record_error::invalid_argument, first);
+		return true;
+	};
+
+	const bool parsed = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+		return (field(std::integral_constant<std::size_t, Is>{}) && ...);
+	}(std::index_sequence_for<Ts...>{});
+
+	if (parsed) {
+		if (!is_record_end(first))
+			fail(sizeof...(Ts), u::record_error::extra_field, first);
+		else first += first != last && *first == '\r';
+	}
+	return result;
+}
+
+// What a chunk looks like under either assumption about whether it starts
+// inside a quoted field, indexed by that assumption.
+struct chunk_summary
+{
+	std::size_t line_feeds[2];
+	std::size_t first_line_feed[2];
+	bool odd_quotes;
+};
+
+[[nodiscard]]
+inline chunk_summary summarize(std::string_view chunk, char quote) noexcept
+{
+	chunk_summary summary{
+		{0, 0},
+		{std::string_view::npos, std::string_view::npos},
+		false};
+
+	bool quoted{false};
+	std::size_t i{0};
+#if defined __SSE2__
+	// Sixteen bytes at once: the prefix sum of the quotes, in parity, tells
+	// which of them are inside quotes.
+	for (; chunk.size() - i >= 16; i += 16) {
+		const __m128i block = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(chunk.data() + i));
+		const auto quotes = static_cast<std::uint32_t>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(block, _mm_set1_epi8(quote))));
+		const auto line_feeds = static_cast<std::uint32_t>(_mm_movemask_epi8(
+			_mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))));
+		if (line_feeds == 0) {
+			quoted = quoted != (std::popcount(quotes) % 2 != 0);
+			continue;
+		}
+
+		std::uint32_t inside = quotes;
+		inside ^= inside << 1;
+		inside ^= inside << 2;
+		inside ^= inside << 4;
+		inside ^= inside << 8;
+		inside = (quoted ? ~inside : inside) & 0xffff;
+
+		for (const bool state : {false, true}) {
+			const std::uint32_t found = line_feeds & (state ? inside : ~inside);
+			if (found == 0)
+				continue;
+			if (summary.line_feeds[state] == 0)
+				summary.first_line_feed[state] = i + std::countr_zero(found);
+			summary.line_feeds[state] += std::popcount(found);
+		}
+		quoted = quoted != (std::popcount(quotes) % 2 != 0);
+	}
+#endif
+	for (; i < chunk.size(); ++i) {
+		if (chunk[i] == quote)
+			quoted = !quoted;
+		else if (chunk[i] == '\n') {
+			// A line feed seen inside quotes is outside of them if the
+			// chunk starts inside quotes.
+			if (summary.line_feeds[quoted]++ == 0)
+				summary.first_line_feed[quoted] = i;
+		}
+	}
+	summary.odd_quotes = quoted;
+	return summary;
+}
+
+// Below this many bytes per thread, starting the threads costs more than
+// they save.
+inline constexpr std::size_t minimum_chunk_size{1 << 16};
+
+}  // namespace detail::record_helpers
+
+// Parses a single record, which ends at the end of `record` or at its first
+// line feed outside of quotes. Offsets in the error are counted from the
+// start of `record`.
+template<u::record_field... Ts>
+[[nodiscard]]
+constexpr u::result<std::tuple<Ts...>, u::located<u::record_error>>
+parse_record(std::string_view record, u::record_format format = {})
+{
+	const char* first = record.data();
+	const char* const base = first;
+
+	std::tuple<Ts...> values{};
+	auto failure = detail::record_helpers::parse_fields(
+		first,
+		first + record.size(),
+		base,
+		format,
+		values);
+	if (failure.has_value())
+		return u::error<u::located<u::record_error>>{failure->error};
+	return values;
+}
+
+// The columns of parsed records, and the records which failed to parse in
+// the order of their rows.
+template<u::record_field... Ts>
+class record_table
+{
+public:
+	template<std::size_t Index>
+	using column_type = std::tuple_element_t<Index, std::tuple<Ts...>>;
+
+	record_table() = default;
+
+	explicit record_table(std::size_t rows)
+		: m_columns{std::make_unique_for_overwrite<Ts[]>(rows)...},
+		  m_rows{rows}
+	{}
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	std::size_t rows() const noexcept
+	{ return this->m_rows; }
+
+	template<std::size_t Index>
+	[[nodiscard]]
+	std::span<const column_type<Index>> column() const noexcept
+	{
+		return std::span<const column_type<Index>>{
+			std::get<Index>(this->m_columns).get(),
+			this->m_rows};
+	}
+
+	template<std::size_t Index>
+	[[nodiscard]]
+	std::span<column_type<Index>> column() noexcept
+	{
+		return std::span<column_type<Index>>{
+			std::get<Index>(this->m_columns).get(),
+			this->m_rows};
+	}
+
+	[[nodiscard]]
+	std::span<const u::record_failure> failures() const noexcept
+	{ return this->m_failures; }
+
+	[[nodiscard]]
+	std::vector<u::record_failure>& failures() noexcept
+	{ return this->m_failures; }
+
+private:
+	std::tuple<std::unique_ptr<Ts[]>...> m_columns;
+	std::size_t m_rows{0};
+	std::vector<u::record_failure> m_failures;
+};
+
+// Parses the records of `input` on up to `threads` threads.
+//
+// The input is cut into one chunk per thread. A first pass over the chunks
+// counts their quotes and line feeds under both assumptions about whether
+// they start inside quotes, which settles where each chunk's first record
+// starts and how many rows it holds. The columns are then allocated once,
+// and a second pass parses each chunk straight into its rows, so that no
+// thread waits on another and nothing is copied to merge the chunks.
+template<u::record_field... Ts>
+[[nodiscard]]
+u::record_table<Ts...> parse_records(
+	std::string_view input,
+	u::record_format format = {},
+	std::size_t threads = std::thread::hardware_concurrency())
+{
+	namespace helpers = detail::record_helpers;
+
+	const std::size_t chunks = std::clamp<std::size_t>(
+		input.size() / helpers::minimum_chunk_size,
+		1,
+		std::max<std::size_t>(threads, 1));
+	const std::size_t chunk_size = input.size() / chunks;
+
+	const auto run = [chunks](auto&& fn) {
+		std::vector<std::jthread> workers;
+		workers.reserve(chunks - 1);
+		for (std::size_t i{1}; i < chunks; ++i)
+			workers.emplace_back(fn, i);
+		fn(0);
+	};
+
+	std::vector<helpers::chunk_summary> summaries(chunks);
+	run([&](std::size_t i) {
+		const std::size_t end = i + 1 == chunks ? input.size() : (i + 1) * chunk_size;
+		summaries[i] = helpers::summarize(
+			input.substr(i * chunk_size, end - i * chunk_size),
+			format.quote);
+	});
+
+	// Every line feed outside quotes ends a record, which belongs to the
+	// chunk holding that line feed, except the last when it ends the input.
+	std::vector<const char*> starts(chunks);
+	std::vector<std::size_t> bases(chunks + 1);
+	bool quoted{false};
+	for (std::size_t i{0}; i < chunks; ++i) {
+		const auto& summary = summaries[i];
+		std::size_t rows = summary.line_feeds[quoted];
+		if (i == 0) {
+			starts[i] = input.data();
+			rows += !input.empty();
+		} else if (rows != 0)
+			starts[i] = input.data()
+				+ i * chunk_size
+				+ summary.first_line_feed[quoted]
+				+ 1;
+
+		quoted = quoted != summary.odd_quotes;
+		if (i + 1 == chunks && rows != 0 && !quoted && input.back() == '\n')
+			--rows;
+		bases[i + 1] = bases[i] + rows;
+	}
+
+	u::record_table<Ts...> table{bases[chunks]};
+	std::vector<std::vector<u::record_failure>> failures(chunks);
+	run([&](std::size_t i) {
+		const char* first = starts[i];
+		const char* const last = input.data() + input.size();
+		for (std::size_t row = bases[i]; row != bases[i + 1]; ++row) {
+			const char* const record = first;
+			std::tuple<Ts...> values{};
+			const auto failure = helpers::parse_fields(
+				first,
+				last,
+				input.data(),
+				format,
+				values);
+			if (failure.has_value()) {
+				failures[i].push_back({row, failure->column, failure->error});
+				values = {};
+				first = helpers::find_record_end(record, last, format.quote);
+			}
+
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				((table.template column<Is>()[row] =
+					std::move(std::get<Is>(values))), ...);
+			}(std::index_sequence_for<Ts...>{});
+
+			first += first != last;
+		}
+	});
+
+	for (auto& chunk_failures : failures)
+		table.failures().insert(
+			table.failures().end(),
+			chunk_failures.begin(),
+			chunk_failures.end());
+	return table;
+}
+
+}
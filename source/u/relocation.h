@@ -0,0 +1,38 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_RELOCATION_H
+
+#include <memory>
+#include <type_traits>
+
+namespace u
+{
+
+// A type is trivially relocatable when moving an object to new storage and
+// ending the lifetime of the original is equivalent to copying its bytes.
+// This holds for every trivially copyable type and for most types that own
+// a resource through a pointer, but not for types that point into
+// themselves (like the small-string buffer of `std::string`). Other types
+// opt in by specializing this trait.
+template<typename T>
+struct is_trivially_relocatable
+	: std::bool_constant<std::is_trivially_copyable_v<T>>
+{};
+
+template<typename T>
+constexpr bool is_trivially_relocatable_v =
+	u::is_trivially_relocatable<T>::value;
+
+template<typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>>
+	: std::bool_constant<true>
+{};
+
+template<typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>>
+	: std::bool_constant<true>
+{};
+
+}
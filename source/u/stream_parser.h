@@ -0,0 +1,105 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_STREAM_PARSER_H
+
+#include <u/config.h>
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+
+namespace u
+{
+
+// Parses integers from input which arrives in chunks, such as the segments
+// of a socket buffer, without gathering them. A number split across chunks
+// is carried over in the parser, so each character is looked at once:
+//
+//	for (std::string_view chunk : chunks) {
+//		while (auto number = parser.parse(chunk)) {
+//			use(number->value());
+//			chunk.remove_prefix(parser.consumed() + 1);
+//		}
+//	}
+//	if (auto last = parser.finish(); last.has_value())
+//		use(*last);
+//
+// `parse` returns no result when the chunk ran out in the middle of a
+// number, and `finish` completes that number at the end of the input. It
+// returns an error when there is none, as after input which ends with a
+// delimiter, such as "1,2,".
+template<u::parsable_integer T, typename E = u::parse_error>
+	requires std::is_constructible_v<E, u::parse_error>
+class stream_parser
+{
+public:
+	constexpr stream_parser() noexcept = default;
+
+	// Parses the number which starts, or carries on, at the start of
+	// `chunk`. A number ends at the first character which is not part of
+	// it; when the chunk ends first, the number is kept to be resumed with
+	// the next chunk and the result is empty.
+	[[nodiscard]]
+	constexpr std::optional<u::result<T, E>> parse(std::string_view chunk)
+	noexcept(std::is_nothrow_constructible_v<E, u::parse_error>)
+	{
+		const char* first = chunk.data();
+		const char* const last = first + chunk.size();
+
+		if constexpr (std::is_signed_v<T>) {
+			if (!this->is_pending() && first != last && *first == '-') {
+				this->m_negative = true;
+				++first;
+			}
+		}
+
+		const std::size_t length = this->m_digits.length;
+		this->m_digits = length == 0
+			? detail::parse_helpers::parse_digits(first, last)
+			: detail::parse_helpers::parse_scalar(first, last, this->m_digits);
+		first += this->m_digits.length - length;
+
+		this->m_consumed = static_cast<std::size_t>(first - chunk.data());
+		if (first == last)
+			return std::nullopt;
+		return this->finish();
+	}
+
+	// Completes the number being parsed at the end of the input.
+	[[nodiscard]]
+	constexpr u::result<T, E> finish()
+	noexcept(std::is_nothrow_constructible_v<E, u::parse_error>)
+	{
+		auto value = detail::parse_helpers::to_integer<T>(
+			this->m_digits,
+			this->m_negative);
+		this->m_digits = {};
+		this->m_negative = false;
+		if (!value.has_value())
+			return u::error<E>{std::in_place, value.error()};
+		return *value;
+	}
+
+	// The number of characters of the last chunk that were parsed.
+	[[nodiscard]]
+	constexpr std::size_t consumed() const noexcept
+	{ return this->m_consumed; }
+
+	// Whether a number was started and is waiting for more input.
+	[[nodiscard]]
+	constexpr bool is_pending() const noexcept
+	{ return this->m_negative || this->m_digits.length != 0; }
+
+private:
+	detail::parse_helpers::digits m_digits{};
+	std::size_t m_consumed{0};
+	bool m_negative{false};
+};
+
+}
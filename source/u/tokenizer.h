@@ -0,0 +1,112 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_TOKENIZER_H
+
+#include <u/config.h>
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include <u/byte_scanner.h>
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+
+namespace u
+{
+
+// Splits an input into tokens separated by any of a set of delimiters. The
+// tokens are views into the input, so over a `u::mapped_file` nothing is
+// copied out of the mapping:
+//
+//	u::tokenizer tokens{file.view(), ",\n"};
+//	while (!tokens.at_end()) {
+//		auto number = tokens.parse<std::int64_t>();
+//		if (!number.has_value())
+//			return report(number.error().location(tokens.input()));
+//		use(*number);
+//	}
+class tokenizer
+{
+public:
+	constexpr tokenizer(
+			std::string_view input,
+			std::string_view delimiters) noexcept
+		: m_input{input},
+		  m_delimiters{delimiters},
+		  m_set{delimiters}
+	{}
+
+	// Returns the text up to the next delimiter and moves past that
+	// delimiter, or nothing at the end of the input.
+	[[nodiscard]]
+	constexpr std::optional<std::string_view> next() noexcept
+	{
+		if (this->at_end())
+			return std::nullopt;
+
+		const std::size_t first = this->m_offset;
+		// A single delimiter is looked for with `memchr`, and more with a
+		// `u::byte_set`.
+		std::size_t last = this->m_delimiters.size() == 1
+			? this->m_input.find(this->m_delimiters.front(), first)
+			: u::find_first_of(this->m_input, this->m_set, first);
+		if (last == std::string_view::npos)
+			last = this->m_input.size();
+
+		this->m_offset = last + (last != this->m_input.size());
+		return this->m_input.substr(first, last - first);
+	}
+
+	// Parses the next token, which must be a number as a whole, and moves
+	// past it whether it parsed or not. The error is located at the first
+	// character which could not be parsed.
+	template<typename T>
+		requires u::parsable_integer<T> || u::parsable_floating_point<T>
+	[[nodiscard]]
+	constexpr u::result<T, u::located<u::parse_error>> parse() noexcept
+	{
+		const std::size_t offset = this->m_offset;
+		const std::string_view token = this->next().value_or(std::string_view{});
+
+		const auto parsed = u::parse<T>(token);
+		if (!parsed.has_value())
+			return u::error<u::located<u::parse_error>>{
+				std::in_place,
+				parsed.error(),
+				offset};
+		if (parsed->length != token.size())
+			return u::error<u::located<u::parse_error>>{
+				std::in_place,
+				u::parse_error::invalid_argument,
+				offset + parsed->length};
+		return parsed->value;
+	}
+
+	//
+	// Observers
+	//
+
+	[[nodiscard]]
+	constexpr bool at_end() const noexcept
+	{ return this->m_offset >= this->m_input.size(); }
+
+	// The offset of the next token in the input.
+	[[nodiscard]]
+	constexpr std::size_t offset() const noexcept
+	{ return this->m_offset; }
+
+	[[nodiscard]]
+	constexpr std::string_view input() const noexcept
+	{ return this->m_input; }
+
+private:
+	std::string_view m_input;
+	std::string_view m_delimiters;
+	u::byte_set m_set;
+	std::size_t m_offset{0};
+};
+
+}
@@ -0,0 +1,298 @@
+// Copyright (C) 2023 King E. Lanchester
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#define U_INCLUDED_UTF8_H
+
+#include <u/config.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if defined __AVX2__
+#	include <immintrin.h>
+#endif
+
+#include <u/diagnostics/result.h>
+#include <u/parsing.h>
+
+namespace u
+{
+
+enum class utf8_error : std::uint8_t
+{
+	// A continuation byte where a character should start.
+	unexpected_continuation = 1,
+	// A character which ends before its continuation bytes do.
+	truncated,
+	// A character encoded in more bytes than it needs.
+	overlong,
+	// A character in the range reserved for UTF-16 surrogates.
+	surrogate,
+	// A character past U+10FFFF, or a byte which never starts one.
+	too_large
+};
+
+namespace detail::utf8_helpers
+{
+
+[[nodiscard]]
+constexpr unsigned byte_at(std::string_view input, std::size_t index) noexcept
+{ return static_cast<unsigned char>(input[index]); }
+
+[[nodiscard]]
+constexpr bool is_continuation(unsigned byte) noexcept
+{ return (byte & 0xC0) == 0x80; }
+
+// Validates `input` from `first`, which must be where a character starts,
+// one character at a time and eight bytes at once while they are ASCII.
+[[nodiscard]]
+constexpr u::result<void, u::located<u::utf8_error>> validate_scalar(
+	std::string_view input,
+	std::size_t first) noexcept
+{
+	const auto fail = [](u::utf8_error error, std::size_t offset) {
+		return u::error<u::located<u::utf8_error>>{std::in_place, error, offset};
+	};
+
+	std::size_t i = first;
+	while (i != input.size()) {
+		if (input.size() - i >= 8
+				&& (parse_helpers::load_eight(input.data() + i)
+					& 0x8080808080808080) == 0) {
+			i += 8;
+			continue;
+		}
+
+		const unsigned lead = utf8_helpers::byte_at(input, i);
+		if (lead < 0x80) {
+			++i;
+			continue;
+		}
+
+		std::size_t length;
+		std::uint32_t code_point;
+		std::uint32_t minimum;
+		if (lead < 0xC0)
+			return fail(u::utf8_error::unexpected_continuation, i);
+		else if (lead < 0xE0)
+			length = 2, code_point = lead & 0x1F, minimum = 0x80;
+		else if (lead < 0xF0)
+			length = 3, code_point = lead & 0x0F, minimum = 0x800;
+		else if (lead < 0xF8)
+			length = 4, code_point = lead & 0x07, minimum = 0x10000;
+		else return fail(u::utf8_error::too_large, i);
+
+		for (std::size_t k{1}; k < length; ++k) {
+			if (i + k == input.size()
+					|| !utf8_helpers::is_continuation(
+						utf8_helpers::byte_at(input, i + k)))
+				return fail(u::utf8_error::truncated, i);
+			code_point = code_point << 6
+				| (utf8_helpers::byte_at(input, i + k) & 0x3F);
+		}
+
+		if (code_point < minimum)
+			return fail(u::utf8_error::overlong, i);
+		if (code_point > 0x10FFFF)
+			return fail(u::utf8_error::too_large, i);
+		if (code_point >= 0xD800 && code_point <= 0xDFFF)
+			return fail(u::utf8_error::surrogate, i);
+		i += length;
+	}
+	return {};
+}
+
+// The start of the character which may run across `offset`, from where
+// validation one character at a time can take over.
+[[nodiscard]]
+constexpr std::size_t character_start(
+	std::string_view input,
+	std::size_t offset) noexcept
+{
+	for (std::size_t back{1}; back <= 3 && back <= offset; ++back)
+		if (!utf8_helpers::is_continuation(
+				utf8_helpers::byte_at(input, offset - back)))
+			return offset - back;
+	return offset;
+}
+
+#if defined __AVX2__
+
+// The lookup tables of Keiser and Lemire, "Validating UTF-8 In Less Than One
+// Instruction Per Byte". Each error sets a bit in the entries for the high
+// nibble and the low nibble of the first byte and the high nibble of the
+// second byte of every pair it can occur in, so that it survives the AND of
+// the three lookups only where all three match.
+inline constexpr std::uint8_t too_short{1 << 0};
+inline constexpr std::uint8_t too_long{1 << 1};
+inline constexpr std::uint8_t overlong_3{1 << 2};
+inline constexpr std::uint8_t too_large_bits{1 << 3};
+inline constexpr std::uint8_t surrogate_bits{1 << 4};
+inline constexpr std::uint8_t overlong_2{1 << 5};
+inline constexpr std::uint8_t too_large_1000{1 << 6};
+inline constexpr std::uint8_t overlong_4{1 << 6};
+inline constexpr std::uint8_t two_continuations{1 << 7};
+inline constexpr std::uint8_t carry = too_short | too_long | two_continuations;
+
+alignas(16) inline constexpr std::array<std::uint8_t, 16> first_high{
+	too_long, too_long, too_long, too_long,
+	too_long, too_long, too_long, too_long,
+	two_continuations, two_continuations, two_continuations, two_continuations,
+	too_short | overlong_2,
+	too_short,
+	too_short | overlong_3 | surrogate_bits,
+	too_short | too_large_bits | too_large_1000 | overlong_4};
+
+alignas(16) inline constexpr std::array<std::uint8_t, 16> first_low{
+	carry | overlong_3 | overlong_2 | overlong_4,
+	carry | overlong_2,
+	carry,
+	carry,
+	carry | too_large_bits,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000 | surrogate_bits,
+	carry | too_large_bits | too_large_1000,
+	carry | too_large_bits | too_large_1000};
+
+alignas(16) inline constexpr std::array<std::uint8_t, 16> second_high{
+	too_short, too_short, too_short, too_short,
+	too_short, too_short, too_short, too_short,
+	too_long | overlong_2 | two_continuations | overlong_3
+		| too_large_1000 | overlong_4,
+	too_long | overlong_2 | two_continuations | overlong_3 | too_large_bits,
+	too_long | overlong_2 | two_continuations | surrogate_bits | too_large_bits,
+	too_long | overlong_2 | two_continuations | surrogate_bits | too_large_bits,
+	too_short, too_short, too_short, too_short};
+
+// The largest value each of the last bytes of a block can have without
+// starting a character which continues into the next block.
+alignas(32) inline constexpr std::array<std::uint8_t, 32> complete_maximum = [] {
+	std::array<std::uint8_t, 32> maximum{};
+	for (auto& byte : maximum)
+		byte = 0xFF;
+	maximum[29] = 0xF0 - 1;
+	maximum[30] = 0xE0 - 1;
+	maximum[31] = 0xC0 - 1;
+	return maximum;
+}();
+
+inline __m256i lookup(const std::array<std::uint8_t, 16>& table, __m256i index) noexcept
+{
+	return _mm256_shuffle_epi8(
+		_mm256_broadcastsi128_si256(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(table.data()))),
+		index);
+}
+
+inline __m256i high_nibbles(__m256i bytes) noexcept
+{ return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F)); }
+
+// The block shifted by `N` bytes, with the last bytes of the previous block
+// shifted in.
+template<int N>
+inline __m256i previous(__m256i block, __m256i previous_block) noexcept
+{
+	return _mm256_alignr_epi8(
+		block,
+		_mm256_permute2x128_si256(previous_block, block, 0x21),
+		16 - N);
+}
+
+// The errors in the characters which end in `block`.
+inline __m256i check_block(__m256i block, __m256i previous_block) noexcept
+{
+	const __m256i first = utf8_helpers::previous<1>(block, previous_block);
+	const __m256i pairs = _mm256_and_si256(
+		_mm256_and_si256(
+			utf8_helpers::lookup(first_high, utf8_helpers::high_nibbles(first)),
+			utf8_helpers::lookup(
+				first_low,
+				_mm256_and_si256(first, _mm256_set1_epi8(0x0F)))),
+		utf8_helpers::lookup(second_high, utf8_helpers::high_nibbles(block)));
+
+	// Where the pair lookup could not tell, the third and fourth bytes of
+	// longer characters must be continuations, and nothing else may be.
+	const __m256i third = _mm256_subs_epu8(
+		utf8_helpers::previous<2>(block, previous_block),
+		_mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+	const __m256i fourth = _mm256_subs_epu8(
+		utf8_helpers::previous<3>(block, previous_block),
+		_mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+	const __m256i must_continue = _mm256_and_si256(
+		_mm256_or_si256(third, fourth),
+		_mm256_set1_epi8(static_cast<char>(0x80)));
+	return _mm256_xor_si256(must_continue, pairs);
+}
+
+// Validates 32 bytes at a time. On the first error, and for the bytes left
+// at the end, validation one character at a time takes over from the start
+// of the last character which was seen whole.
+[[nodiscard]]
+inline u::result<void, u::located<u::utf8_error>> validate_avx2(
+	std::string_view input) noexcept
+{
+	__m256i previous_block = _mm256_setzero_si256();
+	__m256i incomplete = _mm256_setzero_si256();
+
+	std::size_t i{0};
+	for (; input.size() - i >= 32; i += 32) {
+		const __m256i block = _mm256_loadu_si256(
+			reinterpret_cast<const __m256i*>(input.data() + i));
+
+		__m256i error = incomplete;
+		if (_mm256_movemask_epi8(block) != 0) {
+			error = utf8_helpers::check_block(block, previous_block);
+			incomplete = _mm256_subs_epu8(
+				block,
+				_mm256_load_si256(reinterpret_cast<const __m256i*>(
+					complete_maximum.data())));
+		}
+		if (!_mm256_testz_si256(error, error)) [[unlikely]]
+			break;
+		previous_block = block;
+	}
+	return utf8_helpers::validate_scalar(
+		input,
+		utf8_helpers::character_start(input, i));
+}
+
+#endif
+
+}  // namespace detail::utf8_helpers
+
+// Validates that `input` is UTF-8, or fails with the offset of the first
+// character which is not, as a pass before parsing text. With AVX2 enabled
+// it runs 32 bytes at a time.
+[[nodiscard]]
+constexpr u::result<void, u::located<u::utf8_error>> validate_utf8(
+	std::string_view input) noexcept
+{
+#if defined __AVX2__
+	if (!std::is_constant_evaluated())
+		return detail::utf8_helpers::validate_avx2(input);
+#endif
+	return detail::utf8_helpers::validate_scalar(input, 0);
+}
+
+[[nodiscard]]
+inline u::result<void, u::located<u::utf8_error>> validate_utf8(
+	std::span<const std::byte> input) noexcept
+{
+	return u::validate_utf8(std::string_view{
+		reinterpret_cast<const char*>(input.data()),
+		input.size()});
+}
+
+}
@@ -0,0 +1,55 @@
+#include <string>
+
+#include <u/diagnostics/awaiting.h>
+
+namespace
+{
+
+u::result<int, int> halve(int value)
+{
+	if (value % 2 != 0)
+		return u::error{value};
+	return value / 2;
+}
+
+// Coroutines are never constant expressions, so these are only checked to
+// compile here.
+[[maybe_unused]]
+u::result<int, long> quarter(int value)
+{
+	const int half = co_await halve(value);
+	co_return co_await halve(half);
+}
+
+[[maybe_unused]]
+u::result<void, long> require_even(int value)
+{
+	co_await halve(value);
+	co_return {};
+}
+
+[[maybe_unused]]
+u::result<std::string, long> describe(int value)
+{
+	const auto half = halve(value);
+	if (half.value_or(0) < 0)
+		co_return u::error{0L};
+	co_return std::to_string(co_await half);
+}
+
+}
+
+static_assert(std::is_same_v<
+	std::coroutine_traits<u::result<int, long>, int>::promise_type,
+	u::detail::await_helpers::promise<int, long>>);
+
+// An error that cannot become the error of the coroutine is not awaitable.
+template<typename T>
+concept is_awaitable_in_quarter = requires(
+	u::detail::await_helpers::promise<int, long> promise,
+	T result) {
+	promise.await_transform(result);
+};
+
+static_assert(is_awaitable_in_quarter<u::result<int, int>>);
+static_assert(!is_awaitable_in_quarter<u::result<int, std::string>>);
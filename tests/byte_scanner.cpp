@@ -0,0 +1,51 @@
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+
+#include <u/byte_scanner.h>
+
+namespace
+{
+
+constexpr u::byte_set delimiters{",\n\"\\"};
+
+constexpr bool scans_to(
+	std::string_view input,
+	const u::byte_set& set,
+	std::initializer_list<std::size_t> offsets)
+{
+	u::byte_scanner scanner{input, set};
+	auto it = scanner.begin();
+	for (const std::size_t offset : offsets) {
+		if (it == scanner.end() || *it != offset)
+			return false;
+		++it;
+	}
+	return it == scanner.end();
+}
+
+}
+
+static_assert(delimiters.contains(','));
+static_assert(delimiters.contains('\\'));
+static_assert(!delimiters.contains('l'));
+static_assert(!delimiters.contains('<'));
+static_assert(!u::byte_set{}.contains('\0'));
+static_assert(u::byte_set{"\xff\x80\x7f"}.contains('\x80'));
+static_assert(!u::byte_set{"\xff\x80\x7f"}.contains('\x8f'));
+
+static_assert(u::find_first_of("", delimiters) == 0);
+static_assert(u::find_first_of("abc", delimiters) == 3);
+static_assert(u::find_first_of("ab,c", delimiters) == 2);
+static_assert(u::find_first_of("ab,c,", delimiters, 3) == 4);
+static_assert(u::find_first_of(
+	"0123456789012345678901234567890123456789012345678901234567890123456789\n",
+	delimiters) == 70);
+
+static_assert(scans_to("", delimiters, {}));
+static_assert(scans_to("a,b\nc", delimiters, {1, 3}));
+static_assert(scans_to(
+	"\"quoted\\\"\", then a line which runs past the first block of bytes,\n",
+	delimiters,
+	{0, 7, 8, 9, 10, 64, 65}));
+static_assert(scans_to("\xc3\xa9t\xc3\xa9", u::byte_set{"\xa9"}, {1, 4}));
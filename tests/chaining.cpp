@@ -0,0 +1,95 @@
+#include <string>
+
+#include <u/diagnostics/chaining.h>
+
+namespace
+{
+
+struct counted
+{
+	int value;
+	int* moves;
+
+	constexpr counted(int value, int* moves) noexcept
+		: value{value},
+		  moves{moves}
+	{}
+
+	constexpr counted(const counted& other) = delete;
+
+	constexpr counted(counted&& other) noexcept
+		: value{other.value},
+		  moves{other.moves}
+	{ ++*this->moves; }
+};
+
+constexpr u::result<void, int> require_positive(const counted& counted)
+{
+	if (counted.value <= 0)
+		return u::error{counted.value};
+	return {};
+}
+
+}
+
+static_assert([] {
+	int moves{0};
+	u::result<counted, int> source{std::in_place, 7, &moves};
+
+	u::result<counted, long> checked = std::move(source)
+		| u::check(require_positive)
+		| u::check(require_positive)
+		| u::map_error([](int error) { return long{error}; });
+	return checked->value == 7 && moves == 1;
+}());
+
+static_assert([] {
+	int moves{0};
+	u::result<counted, int> source{std::in_place, -2, &moves};
+
+	u::result<counted, std::string> checked = std::move(source)
+		| u::check(require_positive)
+		| u::map_error([](int error) { return std::string(-error, '-'); })
+		| u::map_error([](std::string&& error) { return error + "!"; });
+	return checked.error() == "--!" && moves == 0;
+}());
+
+static_assert([] {
+	const u::result<int, int> source{20};
+
+	const auto halve = [](int value) {
+		if (value % 2 != 0)
+			return u::result<int, int>{u::error_tag, value};
+		return u::result<int, int>{value / 2};
+	};
+	u::result<std::string, int> halved = source
+		| u::then(halve)
+		| u::then(halve)
+		| u::map([](int&& value) { return std::string(value, 'x'); });
+	u::result<int, int> failed = source
+		| u::then(halve)
+		| u::then(halve)
+		| u::then(halve)
+		| u::map([](int&& value) { return value * 100; });
+	return halved.value() == "xxxxx" && failed.error() == 5;
+}());
+
+static_assert([] {
+	u::result<void, int> source{};
+
+	auto counted = (source
+		| u::then([] { return u::result<int, int>{3}; })
+		| u::map([](int&&) {})
+		| u::map([] { return 4; })).evaluate();
+	return std::is_same_v<decltype(counted), u::result<int, int>>
+		&& counted.value() == 4;
+}());
+
+static_assert([] {
+	int first{1};
+	u::result<int&, int> source{first};
+
+	u::result<int&, int> checked = source
+		| u::check([](const int&) { return u::result<void, int>{}; });
+	return &checked.value() == &first;
+}());
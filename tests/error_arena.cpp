@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <u/diagnostics/error_arena.h>
+#include <u/diagnostics/result.h>
+
+static_assert(std::is_trivially_copyable_v<u::error_ref>);
+static_assert(sizeof(u::error_ref) == sizeof(void*));
+static_assert(sizeof(u::result<int, u::error_ref>) == 2 * sizeof(void*));
+static_assert(std::is_trivially_copyable_v<u::result<int, u::error_ref>>);
+static_assert(u::error_ref{}.empty());
+
+namespace
+{
+
+// The arena allocates from the system, so it is checked when the tests
+// start rather than when they compile.
+[[maybe_unused]]
+const bool reuses_blocks = [] {
+	u::error_arena arena;
+	if (arena.capacity() != 0 || arena.used() != 0)
+		__builtin_trap();
+
+	// A first block of 16 KiB, and a second of twice the capacity for a
+	// request which the first cannot hold. The first counts as used whole.
+	void* const small = arena.allocate(100);
+	void* const large = arena.allocate(20'000);
+	if (small == nullptr || large == nullptr
+			|| reinterpret_cast<std::uintptr_t>(large) % alignof(std::max_align_t) != 0
+			|| arena.used() != 16 * 1024 + 20'000
+			|| arena.capacity() != 48 * 1024)
+		__builtin_trap();
+
+	// After a reset, the blocks are filled in again in the same order.
+	arena.reset();
+	if (arena.used() != 0
+			|| arena.allocate(100) != small
+			|| arena.used() != 112
+			|| arena.allocate(20'000) != large
+			|| arena.capacity() != 48 * 1024)
+		__builtin_trap();
+
+	// A block too small for a request is skipped, and still counted.
+	arena.reset();
+	if (arena.allocate(20'000) != large
+			|| arena.used() != 16 * 1024 + 20'000
+			|| arena.allocate(100) == nullptr
+			|| arena.used() != 16 * 1024 + 20'112
+			|| arena.capacity() != 48 * 1024)
+		__builtin_trap();
+	return true;
+}();
+
+[[maybe_unused]]
+const bool makes_messages = [] {
+	const std::string piece{"bc"};
+	const u::error_ref error = u::error_ref::make("a", piece, std::string_view{}, "d");
+	const u::error_ref nothing = u::error_ref::make();
+	if (error.empty()
+			|| error.message() != "abcd"
+			|| error.message().data()[4] != '\0'
+			|| nothing.empty()
+			|| !nothing.message().empty()
+			|| nothing.message().data()[0] != '\0')
+		__builtin_trap();
+	return true;
+}();
+
+}
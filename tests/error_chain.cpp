@@ -0,0 +1,74 @@
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <u/diagnostics/error_chain.h>
+#include <u/diagnostics/result.h>
+
+static_assert(std::is_trivially_copyable_v<u::error_chain>);
+static_assert(sizeof(u::error_chain) == sizeof(void*));
+static_assert(sizeof(u::result<int, u::error_chain>) == 2 * sizeof(void*));
+static_assert(u::error_chain{}.empty());
+
+namespace
+{
+
+u::result<int, u::error_chain> parse_port(std::string_view text)
+{
+	if (text != "80")
+		return u::error<u::error_chain>{u::error_chain::make({
+			.what = "invalid character",
+			.offset = 17})};
+	return 80;
+}
+
+u::result<int, u::error_chain> read_header(std::string_view text)
+{
+	return parse_port(text)
+		| u::with_context({.key = std::string{"port"}})
+		| u::with_context({.what = "while reading the header"});
+}
+
+// The chain lives in the error arena, so it is checked when the tests start
+// rather than when they compile.
+[[maybe_unused]]
+const bool formats_chains = [] {
+	if (!read_header("80").has_value())
+		__builtin_trap();
+
+	const auto failed = read_header("8x");
+	if (failed.has_value())
+		__builtin_trap();
+	const u::error_chain& error = failed.error();
+
+	// The key was copied, so it outlives the string it was given in.
+	if (error.to_string()
+			!= "while reading the header: in \"port\": invalid character at offset 17")
+		__builtin_trap();
+
+	// The contexts from the outermost to the innermost, and the root cause.
+	std::vector<std::string_view> whats;
+	for (const u::error_context& context : error)
+		whats.push_back(context.what);
+	const u::error_context cause = error.root_cause();
+	if (whats != std::vector<std::string_view>{"while reading the header", "", "invalid character"}
+			|| cause.what != "invalid character"
+			|| cause.offset != 17
+			|| !cause.key.empty())
+		__builtin_trap();
+
+	// Each part of a context is optional, and appending keeps what is there.
+	std::string out{"error: "};
+	u::error_chain::make({.key = "name", .offset = 3})
+		.with({.what = "at the root"})
+		.with({})
+		.format_to(out);
+	if (out != "error: : at the root: in \"name\" at offset 3"
+			|| u::error_chain{}.to_string() != ""
+			|| !u::error_chain{}.root_cause().what.empty())
+		__builtin_trap();
+	return true;
+}();
+
+}
@@ -0,0 +1,50 @@
+#include <type_traits>
+#include <vector>
+
+#include <u/diagnostics/error_counters.h>
+#include <u/diagnostics/result.h>
+
+namespace
+{
+
+struct not_found
+{
+	int key;
+};
+
+template<typename T>
+constexpr u::result<T, not_found> fail(int key)
+{ return u::error<not_found>{not_found{key}}; }
+
+}
+
+static_assert(std::is_same_v<
+	decltype(u::error_counts()),
+	std::vector<u::error_site_count>>);
+
+// Counting leaves the result as it was, and a constant expression.
+static_assert(sizeof(u::result<int, not_found>) == 2 * sizeof(int));
+
+static_assert([] {
+	const u::error<not_found> error{not_found{1}};
+	u::result<int, not_found> copied{error};
+	return !copied.has_value()
+		&& copied.error().key == 1
+		&& fail<int>(2).error().key == 2;
+}());
+
+static_assert([] {
+	const u::error<not_found> error{not_found{3}};
+	u::result<int&, not_found> copied{error};
+	return !copied.has_value()
+		&& copied.error().key == 3
+		&& fail<int&>(4).error().key == 4;
+}());
+
+static_assert([] {
+	const u::error<not_found> error{not_found{5}};
+	u::result<void, not_found> copied{error};
+	return !copied.has_value()
+		&& copied.error().key == 5
+		&& fail<void>(6).error().key == 6;
+}());
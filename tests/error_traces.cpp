@@ -0,0 +1,14 @@
+#include <type_traits>
+#include <vector>
+
+#include <u/diagnostics/error_traces.h>
+#include <u/diagnostics/result.h>
+
+static_assert(std::is_same_v<
+	decltype(u::error_traces()),
+	std::vector<u::error_trace>>);
+static_assert(noexcept(u::set_error_trace_period(0)));
+static_assert(noexcept(u::detail::count_down_error_trace()));
+
+static_assert(u::error_trace{}.addresses().empty());
+static_assert(u::error_trace::max_depth == u::error_trace{}.frames.size());
@@ -0,0 +1,80 @@
+#include <optional>
+#include <string_view>
+#include <tuple>
+
+#include <u/grammar.h>
+
+namespace
+{
+
+namespace g = u::grammar;
+
+constexpr auto lower = g::character_set::range('a', 'z');
+constexpr auto word = g::many(g::character(lower), 1);
+
+constexpr auto assignment = g::map(
+	g::sequence(word, g::literal("="), g::number<int>),
+	[](std::string_view name, std::string_view, int value) {
+		return std::pair{name, value};
+	});
+
+constexpr auto sign = g::choice(
+	g::map(g::literal("+"), [](std::string_view) { return 1; }),
+	g::map(g::literal("-"), [](std::string_view) { return -1; }));
+
+template<typename P>
+constexpr bool fails_with(const P& parser, std::string_view input, u::parse_error error)
+{
+	const auto parsed = parser(input);
+	return !parsed.has_value() && parsed.error() == error;
+}
+
+}
+
+static_assert(g::parser<decltype(assignment)>);
+
+static_assert(g::character_set{"ab"}.contains('a'));
+static_assert(!g::character_set{"ab"}.contains('c'));
+static_assert((~g::character_set{"ab"}).contains('\xff'));
+static_assert(!(lower - g::character_set{"x"}).contains('x'));
+static_assert((lower | g::character_set{"_"}).contains('_'));
+
+static_assert([] {
+	const auto parsed = word("abc1");
+	return parsed.has_value() && parsed->value == "abc" && parsed->length == 3;
+}());
+
+static_assert([] {
+	const auto parsed = assignment("answer=42;");
+	return parsed.has_value()
+		&& parsed->value == std::pair<std::string_view, int>{"answer", 42}
+		&& parsed->length == 9;
+}());
+
+static_assert([] {
+	const auto parsed = g::sequence(g::optional(sign), g::number<unsigned>)("-7");
+	return parsed.has_value()
+		&& std::get<0>(parsed->value) == -1
+		&& std::get<1>(parsed->value) == 7u;
+}());
+
+static_assert([] {
+	const auto parsed = g::optional(sign)("7");
+	return parsed.has_value() && !parsed->value.has_value() && parsed->length == 0;
+}());
+
+static_assert([] {
+	const auto parsed = g::many(g::literal("ab"))("ababa");
+	return parsed.has_value() && parsed->value == "abab";
+}());
+
+static_assert([] {
+	const auto parsed = g::many(g::optional(g::literal("x")))("y");
+	return parsed.has_value() && parsed->length == 0;
+}());
+
+static_assert(fails_with(word, "1", u::parse_error::invalid_argument));
+static_assert(fails_with(assignment, "answer:42", u::parse_error::invalid_argument));
+static_assert(fails_with(assignment, "answer=99999999999", u::parse_error::out_of_range));
+static_assert(fails_with(sign, "*", u::parse_error::invalid_argument));
+static_assert(fails_with(g::literal("GET"), "GE", u::parse_error::invalid_argument));
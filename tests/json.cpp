@@ -0,0 +1,142 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <u/json.h>
+
+namespace
+{
+
+namespace json = u::json;
+
+// The quotes of `text`, at most 64 characters, which are not escaped.
+constexpr std::uint64_t unescaped_quotes(std::string_view text, std::uint64_t escaped = 0)
+{
+	char block[64]{};
+	for (std::size_t i{0}; i < text.size(); ++i)
+		block[i] = text[i];
+	const auto masks = json::detail::classify_scalar(block);
+	return masks.quotes & ~json::detail::find_escaped(masks.backslashes, escaped);
+}
+
+constexpr std::size_t number_length(std::string_view text)
+{
+	bool is_integer{false};
+	return json::detail::number_length(text, is_integer);
+}
+
+// Whether parsing `text` fails with `error` at `offset`.
+bool fails_at(std::string_view text, json::error error, std::size_t offset)
+{
+	const auto parsed = json::document::parse(text);
+	return !parsed.has_value()
+		&& parsed.error().error == error
+		&& parsed.error().offset == offset;
+}
+
+// Documents are not constant expressions, so they are checked when the
+// tests start rather than when they compile.
+[[maybe_unused]]
+const bool parses_documents = [] {
+	const std::string_view text = R"({
+		"items": [{"name": "a\u00e9\n", "price": 2.5}, {"price": 3}],
+		"a\"b": 1,
+		"a\\": 2,
+		"\u0041": true,
+		"none": null
+	})";
+	const auto document = json::document::parse(text);
+	if (!document.has_value())
+		__builtin_trap();
+	const json::value root = document->root();
+
+	// Lookup by key and by index.
+	const auto price = root["items"]
+		.and_then([](json::value items) { return items[1]; })
+		.and_then([](json::value item) { return item["price"]; })
+		.and_then([](json::value price) { return price.get<int>(); });
+	const auto name = root["items"]
+		.and_then([](json::value items) { return items[0]; })
+		.and_then([](json::value item) { return item["name"]; });
+	if (!price.has_value() || *price != 3
+			|| !name.has_value()
+			|| name->get<std::string_view>().value_or("") != "a\\u00e9\\n"
+			|| name->get<std::string>().value_or("") != "a\u00e9\n"
+			|| !(*root["none"]).is_null()
+			|| root["items"]->operator[](2).error().error != json::error::index_out_of_range
+			|| root["price"].error().error != json::error::no_such_field
+			|| root["none"]->operator[]("x").error().error != json::error::incorrect_type)
+		__builtin_trap();
+
+	// Names are compared as they are written: a key which ends in a
+	// backslash does not match a longer name at its escaped quote.
+	const auto number = [&](std::string_view key) {
+		return root[key]
+			.and_then([](json::value value) { return value.get<int>(); })
+			.value_or(0);
+	};
+	if (number("a\\") != 0
+			|| number("a\\\\") != 2
+			|| number("a\\\"b") != 1
+			|| !root["\\u0041"].has_value())
+		__builtin_trap();
+
+	// The fields and elements in order, with names unescaped on request.
+	std::vector<std::string> keys;
+	const auto fields = root.fields();
+	for (const json::field& field : *fields)
+		keys.push_back(field.unescaped_key());
+	if (keys != std::vector<std::string>{"items", "a\"b", "a\\", "A", "none"})
+		__builtin_trap();
+	std::size_t count{0};
+	const auto elements = root["items"]->elements();
+	for (const json::value element : *elements)
+		count += element.kind() == json::kind::object;
+	if (count != 2 || root.elements().has_value())
+		__builtin_trap();
+
+	// Invalid names are found by the parse, and invalid strings which are
+	// values when they are read.
+	if (!fails_at(R"({"\u00zz":1})", json::error::invalid_string, 2)
+			|| !fails_at(R"({"\ud83d\ude0":1})", json::error::invalid_string, 2)
+			|| !fails_at(R"({"a\x":1})", json::error::invalid_string, 3)
+			|| !fails_at(R"({"a": 1, "0123456789abcdef\x":1})", json::error::invalid_string, 26)
+			|| !fails_at("{\"a\": 1, \"0123456789abcdef\n\":1}", json::error::invalid_string, 26)
+			|| !fails_at("{\"a\tb\":1}", json::error::invalid_string, 3)
+			|| !fails_at(R"({"a" 1})", json::error::unexpected_character, 5)
+			|| !fails_at(R"([1, 2)", json::error::unexpected_end, 5)
+			|| !fails_at(R"(["a)", json::error::unclosed_string, 1))
+		__builtin_trap();
+	const auto invalid = json::document::parse(R"(["\u00zz"])");
+	if (!invalid.has_value()
+			|| (*invalid->root()[0]).get<std::string>().error().error != json::error::invalid_string)
+		__builtin_trap();
+	return true;
+}();
+
+}
+
+static_assert(unescaped_quotes(R"("a")") == 0b101);
+static_assert(unescaped_quotes(R"("\"")") == 0b1001);
+static_assert(unescaped_quotes(R"("\\")") == 0b1001);
+static_assert(unescaped_quotes(R"("\\\"")") == 0b100001);
+static_assert(unescaped_quotes(R"(\\\\")") == 0b10000);
+static_assert(unescaped_quotes(R"(")", 1) == 0);
+
+static_assert(json::detail::prefix_xor(0b1001) == 0b0111);
+static_assert(json::detail::prefix_xor(std::uint64_t{1} << 63) == std::uint64_t{1} << 63);
+
+static_assert(number_length("0") == 1);
+static_assert(number_length("-12.5e+3,") == 8);
+static_assert(number_length("1E9]") == 3);
+static_assert(number_length("01") == 1);
+static_assert(number_length("-") == 0);
+static_assert(number_length("1.") == 0);
+static_assert(number_length(".5") == 0);
+static_assert(number_length("1e") == 0);
+
+static_assert(json::detail::is_literal("true,", 0, "true"));
+static_assert(json::detail::is_literal("[null]", 1, "null"));
+static_assert(!json::detail::is_literal("truex", 0, "true"));
+static_assert(!json::detail::is_literal("fals", 0, "false"));
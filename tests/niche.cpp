@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <iterator>
+
+#include <u/diagnostics/result.h>
+
+namespace
+{
+
+struct not_found
+{};
+
+enum class color : std::uint8_t
+{
+	red,
+	green,
+	blue,
+};
+
+}
+
+template<>
+struct u::niche_traits<color>
+	: u::enum_niche_traits<color, static_cast<color>(0xFF)>
+{};
+
+static_assert(u::has_niche_v<int*>);
+static_assert(u::has_niche_v<color>);
+static_assert(u::has_niche_v<char*>);
+static_assert(!u::has_niche_v<bool>);
+static_assert(!u::has_niche_v<std::uint32_t>);
+
+static_assert(sizeof(u::result<int*, not_found>) == sizeof(int*));
+static_assert(sizeof(u::result<const double*, not_found>) == sizeof(double*));
+static_assert(sizeof(u::result<char*, not_found>) == sizeof(char*));
+static_assert(sizeof(u::result<color, not_found>) == sizeof(color));
+static_assert(sizeof(u::result<not_found, color>) == sizeof(color));
+static_assert(sizeof(u::result<void, color>) == sizeof(color));
+static_assert(sizeof(u::result<char&, not_found>) == sizeof(char*));
+static_assert(sizeof(u::result<const double&, not_found>) == sizeof(double*));
+
+static_assert(sizeof(u::result<bool, not_found>) == 2 * sizeof(bool));
+static_assert(sizeof(u::result<int*, int>) == 2 * sizeof(int*));
+
+static_assert([] {
+	u::result<color, not_found> value{color::blue};
+	u::result<color, not_found> error{u::error_tag};
+	return value.has_value()
+		&& *value == color::blue
+		&& !error.has_value();
+}());
+
+static_assert([] {
+	u::result<not_found, color> value{};
+	u::result<not_found, color> error{u::error_tag, color::green};
+	error = u::result<not_found, color>{};
+	return value.has_value()
+		&& error.has_value();
+}());
+
+static_assert([] {
+	int object{};
+	u::result<int*, not_found> value{&object};
+	u::result<int*, not_found> null{nullptr};
+	u::result<const int*, not_found> error{u::error_tag};
+	return value.has_value()
+		&& *value == &object
+		&& null.has_value()
+		&& *null == nullptr
+		&& !error.has_value();
+}());
+
+// A pointer one past the end of an array is a value, wherever the array is.
+static_assert([] {
+	int objects[4]{};
+	u::result<int*, not_found> end{objects + 4};
+	u::result<int*, not_found> past{std::end(objects)};
+	return end.has_value()
+		&& *end == objects + 4
+		&& past.has_value();
+}());
+
+static_assert([] {
+	u::result<bool, not_found> value{false};
+	u::result<bool, not_found> error{u::error_tag};
+	return value.has_value()
+		&& !*value
+		&& !error.has_value();
+}());
@@ -0,0 +1,118 @@
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include <u/parsing.h>
+
+namespace
+{
+
+template<typename T>
+constexpr bool parses_to(std::string_view input, T value, std::size_t length)
+{
+	const auto parsed = u::parse<T>(input);
+	return parsed.has_value()
+		&& parsed->value == value
+		&& parsed->length == length;
+}
+
+// Compares bit patterns, so that the sign of zero counts; the literals are
+// rounded by the compiler, which is correct by the standard.
+template<typename T>
+constexpr bool rounds_to(std::string_view input, T value)
+{
+	const auto parsed = u::parse<T>(input);
+	return parsed.has_value()
+		&& std::bit_cast<std::uint64_t>(double{parsed->value})
+			== std::bit_cast<std::uint64_t>(double{value})
+		&& parsed->length == input.size();
+}
+
+template<typename T>
+constexpr bool fails_with(std::string_view input, u::parse_error error)
+{ return u::parse<T>(input).error_or(u::parse_error{}) == error; }
+
+}
+
+static_assert(parses_to<int>("0", 0, 1));
+static_assert(parses_to<int>("42,7", 42, 2));
+static_assert(parses_to<int>("-42 ", -42, 3));
+static_assert(parses_to<unsigned>("0004294967295", 4294967295u, 13));
+static_assert(parses_to<std::int64_t>("-9223372036854775808", INT64_MIN, 20));
+static_assert(parses_to<std::uint64_t>("18446744073709551615x", UINT64_MAX, 20));
+static_assert(parses_to<std::uint64_t>("1234567812345678;", 1234567812345678, 16));
+static_assert(parses_to<std::int8_t>("-128", -128, 4));
+
+static_assert(fails_with<int>("", u::parse_error::invalid_argument));
+static_assert(fails_with<int>("-", u::parse_error::invalid_argument));
+static_assert(fails_with<int>("+1", u::parse_error::invalid_argument));
+static_assert(fails_with<unsigned>("-1", u::parse_error::invalid_argument));
+static_assert(fails_with<std::int8_t>("128", u::parse_error::out_of_range));
+static_assert(fails_with<std::int64_t>("9223372036854775808",
+	u::parse_error::out_of_range));
+static_assert(fails_with<std::uint64_t>("18446744073709551616",
+	u::parse_error::out_of_range));
+static_assert(fails_with<std::uint64_t>("99999999999999999999999",
+	u::parse_error::out_of_range));
+
+// Clinger's fast path, the Eisel-Lemire path, and the boundaries of both.
+static_assert(rounds_to<double>("0", 0.0));
+static_assert(rounds_to<double>("-0", -0.0));
+static_assert(rounds_to<double>("0.1", 0.1));
+static_assert(rounds_to<double>("-.5e-3", -.5e-3));
+static_assert(rounds_to<double>("1.", 1.0));
+static_assert(rounds_to<double>("9007199254740993", 9007199254740993.0));
+static_assert(rounds_to<double>("1e23", 1e23));
+static_assert(rounds_to<double>("8.98846567431158e307", 8.98846567431158e307));
+static_assert(rounds_to<double>("1.7976931348623157e308", 1.7976931348623157e308));
+static_assert(rounds_to<double>("2.2250738585072011e-308", 2.2250738585072011e-308));
+static_assert(rounds_to<double>("2.2250738585072014e-308", 2.2250738585072014e-308));
+static_assert(rounds_to<double>("4.9406564584124654e-324", 4.9406564584124654e-324));
+static_assert(rounds_to<double>("2.4703282292062328e-324", 4.9406564584124654e-324));
+static_assert(rounds_to<double>("0.000000000000000000000000000000000001234",
+	1.234e-36));
+static_assert(rounds_to<double>("123456789012345678901234567890",
+	123456789012345678901234567890.0));
+static_assert(rounds_to<double>("7.2057594037927933e16", 7.2057594037927933e16));
+static_assert(rounds_to<double>("3.14159265358979323846264338327950288",
+	3.14159265358979323846264338327950288));
+static_assert(rounds_to<float>("0.1", 0.1f));
+static_assert(rounds_to<float>("16777217", 16777217.0f));
+static_assert(rounds_to<float>("3.4028234e38", 3.4028234e38f));
+static_assert(rounds_to<float>("1.17549435e-38", 1.17549435e-38f));
+static_assert(rounds_to<float>("1e-45", 1e-45f));
+static_assert(rounds_to<float>("7.1e-46", 1e-45f));
+static_assert(rounds_to<double>("inf", std::numeric_limits<double>::infinity()));
+static_assert(rounds_to<float>("-Infinity",
+	-std::numeric_limits<float>::infinity()));
+
+static_assert(parses_to<double>("1e", 1.0, 1));
+static_assert(parses_to<double>("1e+x", 1.0, 1));
+static_assert(parses_to<double>("25.5,", 25.5, 4));
+static_assert(u::parse<double>("nan(0x1)").value().length == 8);
+static_assert(u::parse<double>("-nan").value().value
+	!= u::parse<double>("-nan").value().value);
+
+static_assert(fails_with<double>("", u::parse_error::invalid_argument));
+static_assert(fails_with<double>(".", u::parse_error::invalid_argument));
+static_assert(fails_with<double>("+1", u::parse_error::invalid_argument));
+static_assert(fails_with<double>("e5", u::parse_error::invalid_argument));
+static_assert(fails_with<double>("in", u::parse_error::invalid_argument));
+static_assert(fails_with<double>("1.8e308", u::parse_error::out_of_range));
+static_assert(fails_with<double>("-1e99999999999", u::parse_error::out_of_range));
+static_assert(fails_with<double>("2.4703282292062327e-324",
+	u::parse_error::underflow));
+static_assert(fails_with<float>("3.5e38", u::parse_error::out_of_range));
+static_assert(fails_with<float>("7e-46", u::parse_error::underflow));
+static_assert(rounds_to<double>("0e99999999999", 0.0));
+
+static_assert(u::locate("", 0).line == 1 && u::locate("", 0).column == 1);
+static_assert(u::locate("abc", 2).line == 1 && u::locate("abc", 2).column == 3);
+static_assert(u::locate("ab\ncd\n\nef", 3).line == 2
+	&& u::locate("ab\ncd\n\nef", 3).column == 1);
+static_assert(u::locate("ab\ncd\n\nef", 8).line == 4
+	&& u::locate("ab\ncd\n\nef", 8).column == 2);
+static_assert(u::locate("ab\n", 99).line == 2 && u::locate("ab\n", 99).column == 1);
+static_assert(u::located<u::parse_error>{u::parse_error::invalid_argument, 5}
+	.location("1,2\n3,x").column == 2);
@@ -0,0 +1,131 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <u/record_parser.h>
+
+namespace
+{
+
+template<typename... Ts>
+constexpr bool fails_at(
+	std::string_view record,
+	u::record_error error,
+	std::size_t offset)
+{
+	const auto parsed = u::parse_record<Ts...>(record);
+	return !parsed.has_value()
+		&& parsed.error().error == error
+		&& parsed.error().offset == offset;
+}
+
+// Rows of an integer, a quoted field holding a line feed, and a plain field,
+// with every 997th row failing at its first field. The input spans several
+// chunks, which start in and out of quoted fields.
+struct generated_records
+{
+	std::string input;
+	std::vector<std::size_t> offsets;
+	std::size_t rows{0};
+
+	explicit generated_records(std::string_view line_end)
+	{
+		for (; this->input.size() < 5 * u::detail::record_helpers::minimum_chunk_size; ++this->rows) {
+			const std::string row = std::to_string(this->rows);
+			if (this->rows % 997 == 0) {
+				this->offsets.push_back(this->input.size());
+				this->input += 'x';
+			}
+			this->input += row + ",\"a \"\"" + row + "\"\"\nb\"," + row;
+			this->input += line_end;
+		}
+	}
+};
+
+// Parses `records` on `threads` threads, and compares every row and failure
+// with what was generated.
+bool parses_generated(const generated_records& records, std::size_t threads)
+{
+	const auto table = u::parse_records<int, std::string, std::string_view>(
+		records.input,
+		{},
+		threads);
+	if (table.rows() != records.rows
+			|| table.failures().size() != records.offsets.size())
+		return false;
+
+	for (std::size_t row{0}; row < records.rows; ++row) {
+		const std::string number = std::to_string(row);
+		if (row % 997 == 0) {
+			const u::record_failure& failure = table.failures()[row / 997];
+			if (failure.row != row
+					|| failure.column != 0
+					|| failure.error.error != u::record_error::invalid_argument
+					|| failure.error.offset != records.offsets[row / 997]
+					|| table.column<0>()[row] != 0
+					|| !table.column<1>()[row].empty())
+				return false;
+			continue;
+		}
+		if (table.column<0>()[row] != static_cast<int>(row)
+				|| table.column<1>()[row] != "a \"" + number + "\"\nb"
+				|| table.column<2>()[row] != number)
+			return false;
+	}
+	return true;
+}
+
+// `parse_records` runs threads, so it is checked when the tests start rather
+// than when they compile.
+[[maybe_unused]]
+const bool parses_records = [] {
+	for (const std::string_view line_end : {"\n", "\r\n"}) {
+		const generated_records records{line_end};
+		for (std::size_t threads{1}; threads <= 8; ++threads)
+			if (!parses_generated(records, threads))
+				__builtin_trap();
+	}
+
+	// The last record counts whether or not a line ends it.
+	const std::string_view inputs[]{"1\n2", "1\n2\n", "1\r\n2\r\n", "\"1\n\"\n"};
+	const std::size_t rows[]{2, 2, 2, 1};
+	for (std::size_t i{0}; i < std::size(inputs); ++i)
+		if (u::parse_records<std::string>(inputs[i], {}, 1).rows() != rows[i])
+			__builtin_trap();
+	return true;
+}();
+
+}
+
+static_assert([] {
+	const auto parsed = u::parse_record<int, double, std::string_view>(
+		"-12,2.5,name\nnext");
+	return parsed.has_value()
+		&& *parsed == std::tuple<int, double, std::string_view>{-12, 2.5, "name"};
+}());
+
+static_assert([] {
+	const auto parsed = u::parse_record<std::string_view, std::string, int>(
+		"\"a,\"\"b\"\"\",\"line\nfeed \"\"x\"\"\",7\r\n");
+	return parsed.has_value()
+		&& std::get<0>(*parsed) == "a,\"\"b\"\""
+		&& std::get<1>(*parsed) == "line\nfeed \"x\""
+		&& std::get<2>(*parsed) == 7;
+}());
+
+static_assert([] {
+	const auto parsed = u::parse_record<std::uint16_t, std::string_view>(
+		"1\t\"tab\"",
+		u::record_format{'\t', '"'});
+	return parsed.has_value() && std::get<1>(*parsed) == "tab";
+}());
+
+static_assert(fails_at<int, int>("1", u::record_error::missing_field, 1));
+static_assert(fails_at<int, int>("1,2,3", u::record_error::extra_field, 3));
+static_assert(fails_at<int, int>("1,2x", u::record_error::invalid_argument, 3));
+static_assert(fails_at<int, int>("1,", u::record_error::invalid_argument, 2));
+static_assert(fails_at<std::int8_t>("128", u::record_error::out_of_range, 0));
+static_assert(fails_at<int, std::string_view>("1,\"ab", u::record_error::unterminated_quote, 2));
+static_assert(fails_at<std::string_view, int>("\"a\"b,1", u::record_error::invalid_argument, 3));
@@ -0,0 +1,225 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <u/diagnostics/result.h>
+#include <u/diagnostics/status_result.h>
+
+namespace
+{
+
+struct trivial
+{
+	int a;
+	int b;
+};
+
+struct not_found
+{};
+
+struct copyable
+{
+	copyable(const copyable&) {}
+	copyable(copyable&&) = default;
+	copyable& operator=(const copyable&) { return *this; }
+	copyable& operator=(copyable&&) = default;
+};
+
+struct destructible
+{
+	~destructible() {}
+};
+
+struct move_only
+{
+	move_only(move_only&&) noexcept = default;
+	move_only& operator=(move_only&&) noexcept = default;
+};
+
+struct immovable
+{
+	immovable(const immovable&) = delete;
+	immovable& operator=(const immovable&) = delete;
+};
+
+// Under the SysV ABI a class no larger than two eightbytes comes back in
+// RAX:RDX only when it is trivial for the purposes of calls.
+template<typename T>
+constexpr bool is_passed_in_registers_v =
+	sizeof(T) <= 16
+	&& std::is_trivially_copy_constructible_v<T>
+	&& std::is_trivially_move_constructible_v<T>
+	&& std::is_trivially_destructible_v<T>;
+
+template<typename T, typename U>
+constexpr bool propagates_triviality_v =
+	std::is_trivially_copy_constructible_v<u::result<T, U>>
+		== (std::is_trivially_copy_constructible_v<T>
+			&& std::is_trivially_copy_constructible_v<U>)
+	&& std::is_trivially_move_constructible_v<u::result<T, U>>
+		== (std::is_trivially_move_constructible_v<T>
+			&& std::is_trivially_move_constructible_v<U>)
+	&& std::is_trivially_copy_assignable_v<u::result<T, U>>
+		== (std::is_trivially_copy_constructible_v<T>
+			&& std::is_trivially_copy_constructible_v<U>
+			&& std::is_trivially_copy_assignable_v<T>
+			&& std::is_trivially_copy_assignable_v<U>
+			&& std::is_trivially_destructible_v<T>
+			&& std::is_trivially_destructible_v<U>)
+	&& std::is_trivially_move_assignable_v<u::result<T, U>>
+		== (std::is_trivially_move_constructible_v<T>
+			&& std::is_trivially_move_constructible_v<U>
+			&& std::is_trivially_move_assignable_v<T>
+			&& std::is_trivially_move_assignable_v<U>
+			&& std::is_trivially_destructible_v<T>
+			&& std::is_trivially_destructible_v<U>)
+	&& std::is_trivially_destructible_v<u::result<T, U>>
+		== (std::is_trivially_destructible_v<T>
+			&& std::is_trivially_destructible_v<U>);
+
+template<typename T, typename U>
+constexpr bool propagates_support_v =
+	std::is_copy_constructible_v<u::result<T, U>>
+		== (std::is_copy_constructible_v<T>
+			&& std::is_copy_constructible_v<U>)
+	&& std::is_move_constructible_v<u::result<T, U>>
+		== (std::is_move_constructible_v<T>
+			&& std::is_move_constructible_v<U>)
+	&& std::is_nothrow_move_constructible_v<u::result<T, U>>
+		== (std::is_nothrow_move_constructible_v<T>
+			&& std::is_nothrow_move_constructible_v<U>);
+
+template<typename T, typename... Us>
+constexpr bool conforms_with_v =
+	(propagates_triviality_v<T, Us> && ...)
+	&& (propagates_triviality_v<Us, T> && ...)
+	&& (propagates_support_v<T, Us> && ...)
+	&& (propagates_support_v<Us, T> && ...);
+
+}
+
+#define U_PAYLOADS \
+	int, \
+	std::uint8_t, \
+	trivial, \
+	int*, \
+	std::string, \
+	std::unique_ptr<int>, \
+	copyable, \
+	destructible, \
+	move_only, \
+	immovable
+
+static_assert(conforms_with_v<int, U_PAYLOADS>);
+static_assert(conforms_with_v<std::uint8_t, U_PAYLOADS>);
+static_assert(conforms_with_v<trivial, U_PAYLOADS>);
+static_assert(conforms_with_v<int*, U_PAYLOADS>);
+static_assert(conforms_with_v<std::string, U_PAYLOADS>);
+static_assert(conforms_with_v<std::unique_ptr<int>, U_PAYLOADS>);
+static_assert(conforms_with_v<copyable, U_PAYLOADS>);
+static_assert(conforms_with_v<destructible, U_PAYLOADS>);
+static_assert(conforms_with_v<move_only, U_PAYLOADS>);
+static_assert(conforms_with_v<immovable, U_PAYLOADS>);
+
+#undef U_PAYLOADS
+
+static_assert(std::is_trivially_copyable_v<u::result<int, int>>);
+static_assert(std::is_trivially_copyable_v<u::result<int*, not_found>>);
+static_assert(std::is_trivially_copyable_v<u::result<not_found, std::uint8_t>>);
+
+static_assert(is_passed_in_registers_v<u::result<int, int>>);
+static_assert(is_passed_in_registers_v<u::result<std::int64_t, int>>);
+static_assert(is_passed_in_registers_v<u::result<trivial, int>>);
+static_assert(is_passed_in_registers_v<u::result<int*, not_found>>);
+static_assert(!is_passed_in_registers_v<u::result<std::string, int>>);
+
+static_assert(is_passed_in_registers_v<u::result<void, int>>);
+static_assert(is_passed_in_registers_v<u::result<void, trivial>>);
+
+static_assert(sizeof(u::result<void, int>) == 8);
+static_assert(sizeof(u::result<void, std::string>)
+	== sizeof(std::string) + alignof(std::string));
+static_assert(is_passed_in_registers_v<u::result<trivial&, int>>);
+static_assert(std::is_trivially_copyable_v<u::result<std::string&, int>>);
+static_assert(!std::is_constructible_v<u::result<const int&, int>, int>);
+
+static_assert(sizeof(u::result<int, int>) == 8);
+static_assert(sizeof(u::result<std::int64_t, int>) == 16);
+
+// Trivially relocatable payloads keep the union size but go through the
+// raw-bytes storage, which is what lets `[[clang::trivial_abi]]` apply.
+static_assert(u::is_trivially_relocatable_v<std::unique_ptr<int>>);
+static_assert(!u::is_trivially_relocatable_v<std::string>);
+static_assert(sizeof(u::result<std::unique_ptr<int>, int>) == 16);
+static_assert(std::is_same_v<
+	u::detail::result_helpers::storage_t<std::unique_ptr<int>, int>,
+	u::detail::result_helpers::relocatable_storage<std::unique_ptr<int>, int>>);
+static_assert(std::is_same_v<
+	u::detail::result_helpers::storage_t<std::string, int>,
+	u::detail::result_helpers::tagged_storage<std::string, int>>);
+
+static_assert([] {
+	u::result<void, int> success;
+	u::result<void, int> failure{u::error_tag, 3};
+
+	const auto next = [] { return u::result<int, int>{5}; };
+	const auto recover = [](int) { return u::result<void, long>{}; };
+	return success.and_then(next).value() == 5
+		&& failure.and_then(next).error() == 3
+		&& failure.or_else(recover).has_value()
+		&& failure.error_or(0) == 3
+		&& success.error_or(0) == 0;
+}());
+
+static_assert([] {
+	int first{1};
+	int second{2};
+
+	u::result<int&, int> reference{first};
+	*reference = 10;
+	reference = second;
+	*reference = 20;
+
+	u::result<const int&, int> failure{u::error_tag, 3};
+	return first == 10
+		&& second == 20
+		&& &failure.value_or(first) == &first
+		&& reference.and_then([](int& value) {
+			return u::result<int, int>{value + 1};
+		}).value() == 21;
+}());
+
+static_assert([] {
+	using parsed = u::result<std::string, int>;
+
+	const auto length = [](std::string&& value) {
+		return u::result<std::size_t, int>{value.size()};
+	};
+	const auto recover = [](int&& error) {
+		return parsed{std::string(error, 'x')};
+	};
+	return parsed{"four"}.and_then(length).value() == 4
+		&& parsed{u::error_tag, 3}.and_then(length).error() == 3
+		&& parsed{u::error_tag, 2}.or_else(recover).value() == "xx"
+		&& parsed{"kept"}.or_else(recover).value() == "kept";
+}());
+
+// The default access policies: `value()` throws and dereferencing only
+// checks in debug builds, so it never throws.
+static_assert(!noexcept(std::declval<u::result<int, int>&>().value()));
+static_assert(noexcept(*std::declval<u::result<int, int>&>()));
+static_assert(noexcept(std::declval<u::result<int, int>&>().operator->()));
+static_assert(noexcept(*std::declval<u::result<void, int>&>()));
+
+static_assert(noexcept(std::declval<u::result<int, not_found>&>().value<U_ACCESS_ASSUME>()));
+static_assert(noexcept(std::declval<u::result<int&, not_found>&>().value<U_ACCESS_TRAP>()));
+static_assert(noexcept(std::declval<u::result<void, not_found>&>().value<U_ACCESS_ASSERT>()));
+static_assert(!noexcept(std::declval<u::result<int, not_found>&>().value<U_ACCESS_THROW>()));
+static_assert(!noexcept(std::declval<u::status_result<int, int>&>().value<U_ACCESS_THROW>()));
+
+static_assert([] {
+	u::result<int, not_found> result{7};
+	return result.value<U_ACCESS_ASSUME>() == 7
+		&& std::move(result).value<U_ACCESS_TRAP>() == 7;
+}());
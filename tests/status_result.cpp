@@ -0,0 +1,58 @@
+#include <cstdint>
+
+#include <sys/types.h>
+
+#include <u/diagnostics/status_result.h>
+
+namespace
+{
+
+enum class status : std::uint16_t
+{
+	ok,
+	busy,
+	denied,
+};
+
+}
+
+static_assert(sizeof(u::status_result<ssize_t, int>) == sizeof(ssize_t));
+static_assert(sizeof(u::status_result<std::int32_t, int>) == 8);
+static_assert(sizeof(u::status_result<std::uint32_t, status>) == 8);
+static_assert(sizeof(u::status_result<std::uint16_t, status>) == 4);
+static_assert(std::is_trivially_copyable_v<u::status_result<ssize_t, int>>);
+
+static_assert([] {
+	u::status_result<ssize_t, int> read{42};
+	u::status_result<ssize_t, int> failure{u::error<int>{4}};
+	return read.has_value()
+		&& *read == 42
+		&& !failure.has_value()
+		&& failure.error() == 4
+		&& failure.value_or(-1) == -1;
+}());
+
+static_assert([] {
+	u::status_result<std::uint32_t, status> success{7u};
+	u::status_result<std::uint32_t, status> failure{
+		u::error_tag,
+		status::denied};
+
+	const auto twice = [](std::uint32_t value) {
+		return u::status_result<std::uint32_t, status>{value * 2};
+	};
+	const auto retry = [](status) {
+		return u::status_result<std::uint32_t, status>{0u};
+	};
+	return success.and_then(twice).value() == 14
+		&& failure.and_then(twice).error() == status::denied
+		&& failure.or_else(retry).has_value();
+}());
+
+static_assert([] {
+	u::status_result<ssize_t, int> failure{u::error_tag, 11};
+	u::result<ssize_t, int> widened = failure;
+	u::status_result<ssize_t, int> narrowed{widened};
+	return widened.error() == 11
+		&& narrowed.error() == 11;
+}());
@@ -0,0 +1,67 @@
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <u/stream_parser.h>
+
+namespace
+{
+
+constexpr std::string_view record{"12,-345,18446744073709551616,,9223372036854775807"};
+
+// Parses `record` split at `split`, and sums the numbers which parsed and
+// the errors which did not.
+constexpr std::int64_t parse_split(std::size_t split)
+{
+	const std::array chunks{record.substr(0, split), record.substr(split)};
+
+	u::stream_parser<std::int64_t> parser;
+	std::int64_t sum{0};
+	const auto add = [&](const u::result<std::int64_t, u::parse_error>& number) {
+		if (number.has_value())
+			sum += *number % 1000;
+		else sum += 1'000'000 * static_cast<int>(number.error());
+	};
+	for (std::string_view chunk : chunks) {
+		while (auto number = parser.parse(chunk)) {
+			add(*number);
+			chunk.remove_prefix(parser.consumed() + 1);
+		}
+	}
+	add(parser.finish());
+	return sum;
+}
+
+constexpr bool parses_at_every_split()
+{
+	const std::int64_t expected = 12 - 345 + 2'000'000 + 1'000'000 + 807;
+	for (std::size_t split{0}; split <= record.size(); ++split)
+		if (parse_split(split) != expected)
+			return false;
+	return true;
+}
+
+}
+
+static_assert(parses_at_every_split());
+
+static_assert([] {
+	u::stream_parser<int> parser;
+	const bool waits = !parser.parse("-").has_value() && parser.is_pending();
+	const bool still_waits = !parser.parse("").has_value();
+	const auto number = parser.parse("42 ");
+	return waits
+		&& still_waits
+		&& number.has_value()
+		&& number->value() == -42
+		&& parser.consumed() == 2
+		&& !parser.is_pending();
+}());
+
+static_assert([] {
+	u::stream_parser<unsigned> parser;
+	const auto number = parser.parse("-1");
+	return number.has_value()
+		&& number->error() == u::parse_error::invalid_argument
+		&& parser.consumed() == 0;
+}());
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <string_view>
+
+#include <u/tokenizer.h>
+
+namespace
+{
+
+template<typename T>
+constexpr bool fails_at(
+	std::string_view input,
+	u::parse_error error,
+	std::size_t offset)
+{
+	u::tokenizer tokens{input, ",\n"};
+	while (!tokens.at_end()) {
+		const auto parsed = tokens.parse<T>();
+		if (!parsed.has_value())
+			return parsed.error().error == error
+				&& parsed.error().offset == offset;
+	}
+	return false;
+}
+
+}
+
+static_assert([] {
+	u::tokenizer tokens{"12,-3\n\n4.5,", ",\n"};
+	const auto first = tokens.next();
+	const auto second = tokens.next();
+	const auto third = tokens.next();
+	const auto fourth = tokens.next();
+	return first == "12"
+		&& second == "-3"
+		&& third == ""
+		&& fourth == "4.5"
+		&& tokens.at_end()
+		&& !tokens.next().has_value();
+}());
+
+static_assert([] {
+	u::tokenizer tokens{"1,-2,3", ","};
+	std::int64_t sum{0};
+	while (!tokens.at_end())
+		sum += tokens.parse<std::int64_t>().value();
+	return sum == 2;
+}());
+
+static_assert([] {
+	u::tokenizer tokens{"0.5\n0.25", "\n"};
+	return tokens.parse<double>().value() == 0.5
+		&& tokens.parse<double>().value() == 0.25;
+}());
+
+static_assert(fails_at<int>("1,2,x3", u::parse_error::invalid_argument, 4));
+static_assert(fails_at<int>("1,23x,4", u::parse_error::invalid_argument, 4));
+static_assert(fails_at<int>("1,,2", u::parse_error::invalid_argument, 2));
+static_assert(fails_at<std::uint8_t>("255\n256", u::parse_error::out_of_range, 4));
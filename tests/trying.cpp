@@ -0,0 +1,38 @@
+#include <u/diagnostics/trying.h>
+
+namespace
+{
+
+constexpr u::result<int, int> halve(int value)
+{
+	if (value % 2 != 0)
+		return u::error{value};
+	return value / 2;
+}
+
+// Statement expressions that return from the enclosing function are not
+// constant expressions, so `U_TRY` is only checked to compile here.
+[[maybe_unused]]
+u::result<int, long> quarter(int value)
+{ return U_TRY(halve(U_TRY(halve(value)))); }
+
+[[maybe_unused]]
+u::result<void, int> require_even(int value)
+{
+	U_TRY(halve(value));
+	return {};
+}
+
+constexpr u::result<int, int> eighth(int value)
+{
+	U_TRY_ASSIGN(const int half, halve(value));
+	U_TRY_ASSIGN(const int quarter, halve(half));
+	U_TRY_ASSIGN(int eighth, halve(quarter));
+	return eighth;
+}
+
+}
+
+static_assert(eighth(16).value() == 2);
+static_assert(eighth(12).error() == 3);
+static_assert(eighth(5).error() == 5);
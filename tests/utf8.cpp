@@ -0,0 +1,30 @@
+#include <string_view>
+
+#include <u/utf8.h>
+
+namespace
+{
+
+constexpr bool fails_at(std::string_view input, u::utf8_error error, std::size_t offset)
+{
+	const auto valid = u::validate_utf8(input);
+	return !valid.has_value()
+		&& valid.error().error == error
+		&& valid.error().offset == offset;
+}
+
+}
+
+static_assert(u::validate_utf8("").has_value());
+static_assert(u::validate_utf8("plain ASCII, long enough for a few words").has_value());
+static_assert(u::validate_utf8("été € \U0001F600 \U0010FFFF").has_value());
+
+static_assert(fails_at("abc\x80", u::utf8_error::unexpected_continuation, 3));
+static_assert(fails_at("abc\xc3", u::utf8_error::truncated, 3));
+static_assert(fails_at("\xe2\x82x", u::utf8_error::truncated, 0));
+static_assert(fails_at("a\xc0\x80", u::utf8_error::overlong, 1));
+static_assert(fails_at("\xe0\x9f\xbf", u::utf8_error::overlong, 0));
+static_assert(fails_at("\xf0\x8f\xbf\xbf", u::utf8_error::overlong, 0));
+static_assert(fails_at("12345678\xed\xa0\x80", u::utf8_error::surrogate, 8));
+static_assert(fails_at("\xf4\x90\x80\x80", u::utf8_error::too_large, 0));
+static_assert(fails_at("\xff", u::utf8_error::too_large, 0));
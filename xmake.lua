@@ -23,3 +23,24 @@ target("tests", {
     files = "tests/*.cpp",
     optimize = "faster",
 })
+
+-- The tests again with errors counted and sampled, which adds a parameter to
+-- the constructors of results and hooks to their bodies.
+target("tests-instrumented", {
+    kind = "binary",
+    deps = "u",
+    files = "tests/*.cpp",
+    defines = {"U_COUNT_RESULT_ERRORS=1", "U_SAMPLE_RESULT_ERRORS=1000"},
+    optimize = "faster",
+})
+
+for _, file in ipairs(os.files("benchmarks/*.cpp")) do
+    target("benchmark-" .. path.basename(file), {
+        kind = "binary",
+        deps = "u",
+        files = file,
+        optimize = "fastest",
+        cxflags = "-march=native",
+        default = false,
+    })
+end